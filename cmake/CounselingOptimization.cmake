@@ -0,0 +1,49 @@
+# Profile-guided and link-time optimization settings for the counseling targets.
+# COUNSELING_PGO selects the stage: GENERATE builds instrumented binaries that write raw
+# profiles into COUNSELING_PGO_DIR, USE rebuilds from the collected profile. GCC matches
+# profiles to object files by path, so both stages must run in the same build directory;
+# the pgo target (cmake/PgoBuild.cmake) takes care of that.
+
+set(COUNSELING_PGO "OFF" CACHE STRING "Profile-guided optimization stage: OFF, GENERATE or USE")
+set_property(CACHE COUNSELING_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(COUNSELING_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH "Directory receiving training profiles")
+option(COUNSELING_LTO "Build the counseling targets with link-time optimization" OFF)
+
+if(COUNSELING_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT counselingLtoSupported OUTPUT counselingLtoError LANGUAGES CXX)
+    if(NOT counselingLtoSupported)
+        message(FATAL_ERROR "Link-time optimization is not supported: ${counselingLtoError}")
+    endif()
+endif()
+
+set(counselingPgoFlags "")
+if(NOT COUNSELING_PGO STREQUAL "OFF")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if(COUNSELING_PGO STREQUAL "GENERATE")
+            # Batch runs are multithreaded, so counters must be updated atomically
+            set(counselingPgoFlags -fprofile-generate=${COUNSELING_PGO_DIR} -fprofile-update=atomic)
+        else()
+            set(counselingPgoFlags -fprofile-use=${COUNSELING_PGO_DIR} -fprofile-correction -Wno-missing-profile)
+        endif()
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if(COUNSELING_PGO STREQUAL "GENERATE")
+            set(counselingPgoFlags -fprofile-instr-generate=${COUNSELING_PGO_DIR}/counseling-%p.profraw)
+        else()
+            set(counselingPgoFlags -fprofile-instr-use=${COUNSELING_PGO_DIR}/counseling.profdata -Wno-profile-instr-unprofiled)
+        endif()
+    else()
+        message(FATAL_ERROR "COUNSELING_PGO needs GCC or Clang, not ${CMAKE_CXX_COMPILER_ID}")
+    endif()
+endif()
+
+# Applies the selected PGO stage and LTO to one target
+function(counseling_optimize target)
+    if(counselingPgoFlags)
+        target_compile_options(${target} PRIVATE ${counselingPgoFlags})
+        target_link_options(${target} PRIVATE ${counselingPgoFlags})
+    endif()
+    if(COUNSELING_LTO)
+        set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION ON)
+    endif()
+endfunction()
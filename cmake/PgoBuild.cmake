@@ -0,0 +1,116 @@
+# Three-stage PGO+LTO build, run with cmake -P by the pgo and pgo-benchmark targets:
+#   1. configure and build an instrumented CLI,
+#   2. train it on a generated workload: repeated dry runs for the CSV parse and lookup loops,
+#      then one batch allocation, analytics and round diff for the remaining paths; dry runs
+#      over a synthetic wide-domain seat matrix, plain and sectioned, cover the filtered
+#      grouped search and the section pager that project.txt's small domain never reaches,
+#   3. rebuild the CLI in the same directory from the profile, with LTO.
+# With BENCHMARK set, a plain -O2 build of the CLI is timed against the optimized one.
+#
+# Inputs: SOURCE_DIR, BINARY_DIR, GENERATOR, CXX_COMPILER, CXX_COMPILER_ID, WORKLOAD (counseling_workload),
+#         APPLICANTS (row count), optionally PROFDATA (llvm-profdata), BENCHMARK, REPEATS.
+
+foreach(input SOURCE_DIR BINARY_DIR GENERATOR CXX_COMPILER CXX_COMPILER_ID WORKLOAD APPLICANTS)
+    if(NOT DEFINED ${input})
+        message(FATAL_ERROR "PgoBuild.cmake needs -D${input}=...")
+    endif()
+endforeach()
+
+set(releaseFlags "-O2 -DNDEBUG")
+set(optimizedDir "${BINARY_DIR}/optimized")
+set(profileDir "${BINARY_DIR}/profile")
+set(trainingDir "${BINARY_DIR}/training")
+
+function(run_checked)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Command failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+# Configures and builds the CLI in buildDir with extra cache settings
+function(build_cli buildDir)
+    run_checked(${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${buildDir} -G ${GENERATOR}
+                -DCMAKE_CXX_COMPILER=${CXX_COMPILER} -DCMAKE_BUILD_TYPE=Release
+                "-DCMAKE_CXX_FLAGS_RELEASE=${releaseFlags}" ${ARGN})
+    run_checked(${CMAKE_COMMAND} --build ${buildDir} --config Release --target counseling_cli)
+endfunction()
+
+# Path of the CLI built in buildDir, for single- and multi-config generators
+function(cli_path buildDir outVar)
+    foreach(candidate "${buildDir}/Release/project${CMAKE_EXECUTABLE_SUFFIX}" "${buildDir}/project${CMAKE_EXECUTABLE_SUFFIX}")
+        if(EXISTS "${candidate}")
+            set(${outVar} "${candidate}" PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+    message(FATAL_ERROR "No CLI found in ${buildDir}")
+endfunction()
+
+# Training data: the shipped seat matrix and a reproducible applicant file
+file(MAKE_DIRECTORY ${trainingDir})
+file(WRITE ${trainingDir}/counseling.conf "seat_matrix = ${SOURCE_DIR}/project.txt\n")
+set(applicantFile ${trainingDir}/applicants.csv)
+if(NOT EXISTS ${applicantFile})
+    run_checked(${WORKLOAD} ${SOURCE_DIR}/project.txt ${applicantFile} ${APPLICANTS})
+endif()
+
+# Wide-domain seat matrix in its own directory, and its sectioned snapshot in another
+set(wideDir ${trainingDir}/wide)
+set(sectionedDir ${trainingDir}/sectioned)
+file(MAKE_DIRECTORY ${wideDir} ${sectionedDir})
+file(WRITE ${wideDir}/counseling.conf "seat_matrix = ${wideDir}/seat_matrix.txt\n")
+file(WRITE ${sectionedDir}/counseling.conf "seat_matrix = ${sectionedDir}/seat_matrix.snapshot\n")
+set(wideApplicantFile ${wideDir}/applicants.csv)
+if(NOT EXISTS ${wideApplicantFile})
+    run_checked(${WORKLOAD} --seat-matrix ${wideDir}/seat_matrix.txt ${sectionedDir}/seat_matrix.snapshot)
+    run_checked(${WORKLOAD} ${wideDir}/seat_matrix.txt ${wideApplicantFile} ${APPLICANTS})
+endif()
+
+# Stage 1: instrumented build
+file(REMOVE_RECURSE ${profileDir})
+file(MAKE_DIRECTORY ${profileDir})
+build_cli(${optimizedDir} -DCOUNSELING_PGO=GENERATE -DCOUNSELING_LTO=ON -DCOUNSELING_PGO_DIR=${profileDir})
+cli_path(${optimizedDir} instrumentedCli)
+
+# Stage 2: training run
+file(GLOB staleRunFiles ${trainingDir}/round_checkpoint.bin* ${trainingDir}/allocation_journal.bin)
+if(staleRunFiles)
+    file(REMOVE ${staleRunFiles})
+endif()
+# Each run is "directory|arguments"
+foreach(run "${trainingDir}|--dry-run;${applicantFile};5" "${trainingDir}|--batch;${applicantFile};100000"
+            "${trainingDir}|--analytics;${applicantFile};1" "${trainingDir}|--diff;${applicantFile};1;2"
+            "${wideDir}|--dry-run;${wideApplicantFile};3" "${sectionedDir}|--dry-run;${wideApplicantFile};3")
+    string(FIND "${run}" "|" separator)
+    string(SUBSTRING "${run}" 0 ${separator} directory)
+    math(EXPR separator "${separator} + 1")
+    string(SUBSTRING "${run}" ${separator} -1 arguments)
+    execute_process(COMMAND ${instrumentedCli} ${arguments} WORKING_DIRECTORY ${directory}
+                    RESULT_VARIABLE result OUTPUT_QUIET)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Training run failed (${result}) in ${directory}: ${arguments}")
+    endif()
+endforeach()
+if(CXX_COMPILER_ID MATCHES "Clang")
+    if(NOT PROFDATA)
+        message(FATAL_ERROR "Clang PGO needs llvm-profdata (-DPROFDATA=...)")
+    endif()
+    file(GLOB rawProfiles ${profileDir}/*.profraw)
+    run_checked(${PROFDATA} merge -o ${profileDir}/counseling.profdata ${rawProfiles})
+endif()
+
+# Stage 3: optimized build from the profile
+build_cli(${optimizedDir} -DCOUNSELING_PGO=USE -DCOUNSELING_LTO=ON -DCOUNSELING_PGO_DIR=${profileDir})
+cli_path(${optimizedDir} optimizedCli)
+message(STATUS "PGO+LTO build: ${optimizedCli}")
+
+if(BENCHMARK)
+    set(baselineDir "${BINARY_DIR}/baseline")
+    build_cli(${baselineDir} -DCOUNSELING_PGO=OFF -DCOUNSELING_LTO=OFF)
+    cli_path(${baselineDir} baselineCli)
+    if(NOT REPEATS)
+        set(REPEATS 5)
+    endif()
+    run_checked(${BENCHMARK} ${trainingDir} ${applicantFile} ${REPEATS} "O2=${baselineCli}" "PGO+LTO=${optimizedCli}")
+endif()
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace CollegeCounseling {
+    // Thin RAII wrapper over a raw file descriptor, used where data must reach the disk
+    class DurableFile {
+    private:
+        int fd = -1;
+        std::string path;
+
+    public:
+        // Opens (creating if needed) a file for reading and writing
+        explicit DurableFile(const std::string& filePath) : path(filePath) {
+#ifdef _WIN32
+            fd = ::_open(filePath.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+            fd = ::open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+#endif
+            if (fd < 0) {
+                throw std::runtime_error("Error: Cannot open " + filePath);
+            }
+        }
+
+        DurableFile(const DurableFile&) = delete;
+        DurableFile& operator=(const DurableFile&) = delete;
+
+        ~DurableFile() {
+#ifdef _WIN32
+            ::_close(fd);
+#else
+            ::close(fd);
+#endif
+        }
+
+        // Current size of the file in bytes
+        std::uint64_t size() const {
+#ifdef _WIN32
+            struct _stat64 info;
+            if (::_fstat64(fd, &info) != 0) {
+#else
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+#endif
+                throw std::runtime_error("Error: Cannot stat " + path);
+            }
+            return static_cast<std::uint64_t>(info.st_size);
+        }
+
+        // Reads up to length bytes from the start of the file; returns the number read
+        size_t readPrefix(void* buffer, size_t length) const {
+            char* bytes = static_cast<char*>(buffer);
+            size_t done = 0;
+#ifdef _WIN32
+            ::_lseeki64(fd, 0, SEEK_SET);
+#endif
+            while (done < length) {
+#ifdef _WIN32
+                long got = ::_read(fd, bytes + done, static_cast<unsigned>(length - done));
+#else
+                ssize_t got = ::pread(fd, bytes + done, length - done, static_cast<off_t>(done));
+#endif
+                if (got < 0) {
+                    throw std::runtime_error("Error: Cannot read " + path);
+                }
+                if (got == 0) {
+                    break;
+                }
+                done += static_cast<size_t>(got);
+            }
+            return done;
+        }
+
+        // Drops everything past the given length, used to cut off a torn tail
+        void truncate(std::uint64_t length) {
+#ifdef _WIN32
+            if (::_chsize_s(fd, static_cast<__int64>(length)) != 0) {
+#else
+            if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+#endif
+                throw std::runtime_error("Error: Cannot truncate " + path);
+            }
+        }
+
+        // Appends a buffer at the end of the file
+        void append(const void* data, size_t length) {
+#ifdef _WIN32
+            ::_lseeki64(fd, 0, SEEK_END);
+#else
+            ::lseek(fd, 0, SEEK_END);
+#endif
+            const char* bytes = static_cast<const char*>(data);
+            while (length > 0) {
+#ifdef _WIN32
+                long written = ::_write(fd, bytes, static_cast<unsigned>(length));
+#else
+                ssize_t written = ::write(fd, bytes, length);
+#endif
+                if (written <= 0) {
+                    throw std::runtime_error("Error: Cannot write " + path);
+                }
+                bytes += written;
+                length -= static_cast<size_t>(written);
+            }
+        }
+
+        // Forces written data to stable storage
+        void sync() {
+#ifdef _WIN32
+            if (::_commit(fd) != 0) {
+#else
+            if (::fsync(fd) != 0) {
+#endif
+                throw std::runtime_error("Error: Cannot sync " + path);
+            }
+        }
+    };
+
+    // Fixed-size binary record for one allocation decision, stored in host byte order
+    struct AllocationRecord {
+        std::int32_t applicantId;
+        std::int32_t round;
+        std::int32_t collegeId;
+        std::uint32_t snapshotVersion;
+    };
+    static_assert(sizeof(AllocationRecord) == 16, "AllocationRecord must stay 16 bytes on disk");
+
+    // Append-only journal of allocation decisions with group commit.
+    // Appenders only buffer records; whoever calls commit() (or fills the batch) becomes the
+    // leader, writes every pending record and issues a single fsync for the whole group.
+    class AllocationJournal {
+    private:
+        // File header: magic, format version, record size
+        static constexpr char magic[4] = { 'C', 'C', 'J', 'L' };
+        static constexpr std::uint32_t formatVersion = 1;
+        static constexpr size_t headerSize = 12;
+
+        DurableFile file;
+        size_t groupCommitSize;
+
+        std::mutex journalMutex;
+        std::condition_variable syncDone;
+        std::vector<AllocationRecord> pending;
+        std::uint64_t appendedCount = 0;
+        std::uint64_t durableCount = 0;
+        bool syncInProgress = false;
+        // Set when a group commit fails; its records may be partly on disk, so nothing
+        // later can be reported durable and every further append or commit throws
+        bool failed = false;
+
+    public:
+        // Opens or creates a journal; a torn record left by a crash is cut off
+        explicit AllocationJournal(const std::string& journalPath, size_t batchSize = 4096)
+            : file(journalPath), groupCommitSize(batchSize == 0 ? 1 : batchSize) {
+            std::uint64_t length = file.size();
+            if (length == 0) {
+                char header[headerSize];
+                writeHeader(header);
+                file.append(header, headerSize);
+                file.sync();
+                return;
+            }
+            // Only the header is read, so opening costs the same however long the journal grows
+            char header[headerSize];
+            checkHeader(header, file.readPrefix(header, headerSize));
+            std::uint64_t complete = headerSize + (length - headerSize) / sizeof(AllocationRecord) * sizeof(AllocationRecord);
+            if (complete != length) {
+                file.truncate(complete);
+                file.sync();
+            }
+        }
+
+        AllocationJournal(const AllocationJournal&) = delete;
+        AllocationJournal& operator=(const AllocationJournal&) = delete;
+
+        // Flushes whatever is still buffered, unless an earlier commit already failed
+        ~AllocationJournal() {
+            if (failed) {
+                return;
+            }
+            try {
+                commit();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+
+        // Buffers a decision; the caller leads a group commit once the batch is full
+        void append(const AllocationRecord& record) {
+            std::unique_lock<std::mutex> lock(journalMutex);
+            checkNotFailed();
+            pending.push_back(record);
+            ++appendedCount;
+            if (pending.size() >= groupCommitSize) {
+                commitLocked(lock, appendedCount);
+            }
+        }
+
+        // Blocks until every record appended so far is on stable storage
+        void commit() {
+            std::unique_lock<std::mutex> lock(journalMutex);
+            commitLocked(lock, appendedCount);
+        }
+
+        // Reads every complete record of a journal in one pass
+        static std::vector<AllocationRecord> replay(const std::string& journalPath) {
+            std::ifstream input(journalPath, std::ios::binary | std::ios::ate);
+            if (!input.is_open()) {
+                throw std::runtime_error("Error: Cannot open allocation journal.");
+            }
+            std::vector<char> contents(static_cast<size_t>(input.tellg()));
+            input.seekg(0);
+            input.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+            checkHeader(contents.data(), contents.size());
+
+            std::vector<AllocationRecord> records((contents.size() - headerSize) / sizeof(AllocationRecord));
+            if (!records.empty()) {
+                std::memcpy(records.data(), contents.data() + headerSize, records.size() * sizeof(AllocationRecord));
+            }
+            return records;
+        }
+
+    private:
+        // Runs or waits for group commits until the first target records are durable
+        void commitLocked(std::unique_lock<std::mutex>& lock, std::uint64_t target) {
+            while (durableCount < target) {
+                checkNotFailed();
+                if (syncInProgress) {
+                    syncDone.wait(lock);
+                    continue;
+                }
+                syncInProgress = true;
+                std::vector<AllocationRecord> batch;
+                batch.swap(pending);
+                std::uint64_t batchEnd = appendedCount;
+                lock.unlock();
+                try {
+                    file.append(batch.data(), batch.size() * sizeof(AllocationRecord));
+                    file.sync();
+                } catch (...) {
+                    lock.lock();
+                    failed = true;
+                    syncInProgress = false;
+                    syncDone.notify_all();
+                    throw;
+                }
+                lock.lock();
+                syncInProgress = false;
+                durableCount = batchEnd;
+                syncDone.notify_all();
+            }
+        }
+
+        void checkNotFailed() const {
+            if (failed) {
+                throw std::runtime_error("Error: Allocation journal is unusable after a failed commit.");
+            }
+        }
+
+        static void writeHeader(char* header) {
+            std::uint32_t recordSize = sizeof(AllocationRecord);
+            std::memcpy(header, magic, 4);
+            std::memcpy(header + 4, &formatVersion, 4);
+            std::memcpy(header + 8, &recordSize, 4);
+        }
+
+        static void checkHeader(const char* contents, size_t length) {
+            char expected[headerSize];
+            writeHeader(expected);
+            if (length < headerSize || std::memcmp(contents, expected, headerSize) != 0) {
+                throw std::runtime_error("Error: Invalid allocation journal header.");
+            }
+        }
+    };
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace CollegeCounseling {
+    // Abstract base class for allocation strategies
+    class AllocationStrategy {
+    public:
+        // Sentinel ID returned when no college covers a rank
+        static constexpr int noCollegeId = -1;
+
+        virtual ~AllocationStrategy() = default;
+
+        virtual std::string allocateCollege(int userRank) const = 0;
+
+        // Returns the ID of the allocated college; strategies without a college table return noCollegeId
+        virtual int allocateCollegeId(int /*userRank*/) const {
+            return noCollegeId;
+        }
+
+        // Batch form of allocateCollegeId; strategies with an index override it to overlap lookups
+        virtual void allocateCollegeIds(const std::int32_t* userRanks, std::int32_t* collegeIds, size_t count) const {
+            for (size_t i = 0; i < count; ++i) {
+                collegeIds[i] = allocateCollegeId(userRanks[i]);
+            }
+        }
+    };
+
+    // Derived classes with alternative allocation strategies
+    class AnotherStrategy : public AllocationStrategy {
+    public:
+        // Override of the virtual function with a different allocation logic
+        std::string allocateCollege(int /*userRank*/) const override {
+            // Implement your allocation logic here
+            return "not eligible for round two";
+        }
+    };
+
+    class YetAnotherStrategy : public AllocationStrategy {
+    public:
+        // Override of the virtual function with another allocation logic
+        std::string allocateCollege(int /*userRank*/) const override {
+            // Implement your allocation logic here
+            return "not eligible for round three";
+        }
+    };
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bits.h"
+#include "CollegeApplication.h"
+#include "HugePages.h"
+#include "MappedFile.h"
+
+namespace CollegeCounseling {
+    // Byte range of one CSV field inside the parsed buffer
+    struct FieldSpan {
+        size_t offset;
+        std::uint32_t length;
+        bool quoted;
+    };
+
+    // Column-oriented view of an applicant CSV: the file mapping is kept and fields are
+    // spans into it, so parsing allocates per column, never per field
+    struct ApplicantColumns {
+        MappedFile buffer;
+        std::vector<FieldSpan> names;
+        HugeVector<std::int32_t> ranks;
+        std::vector<FieldSpan> categories;
+
+        size_t size() const {
+            return ranks.size();
+        }
+
+        // Raw field text; a quoted field excludes its outer quotes but keeps doubled quotes
+        std::string_view field(const FieldSpan& span) const {
+            return std::string_view(buffer.data() + span.offset, span.length);
+        }
+
+        // Applicant name with CSV quoting undone
+        std::string name(size_t row) const {
+            std::string_view raw = field(names[row]);
+            if (!names[row].quoted) {
+                return std::string(raw);
+            }
+            std::string unescaped;
+            unescaped.reserve(raw.size());
+            for (size_t i = 0; i < raw.size(); ++i) {
+                unescaped.push_back(raw[i]);
+                if (raw[i] == '"' && i + 1 < raw.size() && raw[i + 1] == '"') {
+                    ++i;
+                }
+            }
+            return unescaped;
+        }
+
+        // Category, "GM" when the row has none
+        std::string_view category(size_t row) const {
+            return categories[row].length == 0 ? std::string_view("GM") : field(categories[row]);
+        }
+    };
+
+    // Parses "name,rank[,category,...]" applicant files (optionally with a header row) through a
+    // SIMD structural index. Each 64-byte block gives bitmasks of quotes, commas and newlines;
+    // a prefix XOR over the quote mask (carried across blocks) marks the bytes inside quoted
+    // fields, and only separators outside quotes become structural positions. Unquoted names
+    // may still contain commas: fields are resolved from the right, the rightmost all-digit field
+    // being the rank and the one after it the category (which may itself hold digits, as
+    // KCET's 1G or 2AG do); further columns are ignored, so they must not be all digits.
+    // Ranks of up to eight digits are converted with one SWAR multiply sequence.
+    class ApplicantCsvParser {
+    public:
+        static ApplicantColumns parseFile(const std::string& applicantFile) {
+            return parseFile(MappedFile::open(applicantFile));
+        }
+
+        // Takes ownership of an opened applicant file; the columns keep its mapping alive
+        static ApplicantColumns parseFile(MappedFile applicantFile) {
+            ApplicantColumns columns;
+            columns.buffer = std::move(applicantFile);
+            parse(columns);
+            return columns;
+        }
+
+        // Indexes columns.buffer and fills the column vectors
+        static void parse(ApplicantColumns& columns) {
+            const MappedFile& buffer = columns.buffer;
+            std::vector<size_t> separators;
+            separators.reserve(buffer.size() / 16);
+            if (!findSeparators(buffer.data(), buffer.size(), separators)) {
+                throw std::runtime_error("Error: Unterminated quote in applicant file.");
+            }
+            separators.push_back(buffer.size());
+
+            size_t rowEstimate = static_cast<size_t>(std::count_if(separators.begin(), separators.end(),
+                [&buffer](size_t p) { return p == buffer.size() || buffer[p] == '\n'; }));
+            columns.names.reserve(rowEstimate);
+            columns.ranks.reserve(rowEstimate);
+            columns.categories.reserve(rowEstimate);
+
+            size_t fieldStart = 0;
+            std::vector<size_t> commas;
+            for (size_t position : separators) {
+                if (position < buffer.size() && buffer[position] == ',') {
+                    commas.push_back(position);
+                    continue;
+                }
+                // A first line without any digit is a header row
+                if (fieldStart != 0 || containsDigit(buffer.data(), buffer.data() + position)) {
+                    addRow(columns, fieldStart, position, commas);
+                }
+                fieldStart = position + 1;
+                commas.clear();
+            }
+        }
+
+    private:
+        // Positions of commas and newlines that are not inside quotes; false when the
+        // file ends inside a quoted field
+        static bool findSeparators(const char* data, size_t size, std::vector<size_t>& separators) {
+            std::uint64_t insideCarry = 0;
+            size_t offset = 0;
+            char tail[64];
+            while (offset < size) {
+                const char* block = data + offset;
+                std::uint64_t validBytes = ~std::uint64_t(0);
+                if (size - offset < 64) {
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, block, size - offset);
+                    block = tail;
+                    validBytes = (std::uint64_t(1) << (size - offset)) - 1;
+                }
+
+                std::uint64_t quotes = ByteScanner::equalMask(block, '"') & validBytes;
+                std::uint64_t inside = prefixXor(quotes) ^ insideCarry;
+                insideCarry = static_cast<std::uint64_t>(static_cast<std::int64_t>(inside) >> 63);
+                std::uint64_t structural = (ByteScanner::equalMask(block, ',') | ByteScanner::equalMask(block, '\n'))
+                                         & ~inside & validBytes;
+                while (structural != 0) {
+                    separators.push_back(offset + static_cast<size_t>(countTrailingZeros(structural)));
+                    structural &= structural - 1;
+                }
+                offset += 64;
+            }
+            return insideCarry == 0;
+        }
+
+        // Bit i becomes the XOR of bits 0..i, so bits between an opening and closing quote are set
+        static std::uint64_t prefixXor(std::uint64_t bits) {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        // Builds one row from its line bounds and the positions of its unquoted commas
+        static void addRow(ApplicantColumns& columns, size_t lineStart, size_t lineEnd, const std::vector<size_t>& commas) {
+            const char* data = columns.buffer.data();
+            if (lineEnd > lineStart && data[lineEnd - 1] == '\r') {
+                --lineEnd;
+            }
+            if (lineEnd == lineStart) {
+                return;
+            }
+            if (commas.empty()) {
+                throw std::runtime_error("Error: Invalid applicant line: " + std::string(data + lineStart, data + lineEnd));
+            }
+
+            // Field k (k >= 1) runs from commas[k - 1] to the next comma or the line end; field 0
+            // is always part of the name
+            auto fieldEnd = [&](size_t k) { return k < commas.size() ? commas[k] : lineEnd; };
+            size_t rankField = commas.size();
+            while (rankField > 0 && !isNumber(data + commas[rankField - 1] + 1, data + fieldEnd(rankField))) {
+                --rankField;
+            }
+            if (rankField == 0) {
+                throw std::runtime_error("Error: Invalid rank in applicant line: " + std::string(data + lineStart, data + lineEnd));
+            }
+
+            int rank = parseRank(data + commas[rankField - 1] + 1, data + fieldEnd(rankField));
+            if (rank < 0) {
+                throw std::runtime_error("Error: Invalid rank in applicant line: " + std::string(data + lineStart, data + lineEnd));
+            }
+            FieldSpan category{ 0, 0, false };
+            if (rankField < commas.size()) {
+                category = span(data, commas[rankField] + 1, fieldEnd(rankField + 1));
+            }
+            columns.names.push_back(span(data, lineStart, commas[rankField - 1]));
+            columns.ranks.push_back(rank);
+            columns.categories.push_back(category);
+        }
+
+        // Field span with surrounding spaces trimmed and outer quotes removed
+        static FieldSpan span(const char* data, size_t first, size_t last) {
+            while (first < last && data[first] == ' ') {
+                ++first;
+            }
+            while (last > first && data[last - 1] == ' ') {
+                --last;
+            }
+            bool quoted = last - first >= 2 && data[first] == '"' && data[last - 1] == '"';
+            if (quoted) {
+                ++first;
+                --last;
+            }
+            return { first, static_cast<std::uint32_t>(last - first), quoted };
+        }
+
+        // True for a field that is one or more digits, ignoring surrounding spaces
+        static bool isNumber(const char* first, const char* last) {
+            while (first < last && *first == ' ') {
+                ++first;
+            }
+            while (last > first && last[-1] == ' ') {
+                --last;
+            }
+            if (first == last) {
+                return false;
+            }
+            for (; first < last; ++first) {
+                if (*first < '0' || *first > '9') {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool containsDigit(const char* first, const char* last) {
+            for (; first < last; ++first) {
+                if (*first >= '0' && *first <= '9') {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Parses a non-negative rank; returns -1 on malformed input
+        static int parseRank(const char* first, const char* last) {
+            while (first < last && *first == ' ') {
+                ++first;
+            }
+            while (last > first && last[-1] == ' ') {
+                --last;
+            }
+            size_t length = static_cast<size_t>(last - first);
+            if (length == 0 || length > 8) {
+                int value = 0;
+                std::from_chars_result parsed = std::from_chars(first, last, value);
+                return parsed.ec == std::errc() && parsed.ptr == last && length != 0 ? value : -1;
+            }
+
+            // Right-align the digits in a word padded with '0', check all eight bytes are
+            // digits, then combine pairs, quads and halves with three multiplies
+            std::uint64_t word = 0x3030303030303030ull;
+            std::memcpy(reinterpret_cast<char*>(&word) + (8 - length), first, length);
+            std::uint64_t digits = word - 0x3030303030303030ull;
+            if (((word & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull) || ((digits + 0x7676767676767676ull) & 0x8080808080808080ull)) {
+                return -1;
+            }
+            digits = (digits * 10 + (digits >> 8)) & 0x00FF00FF00FF00FFull;
+            digits = (digits * 100 + (digits >> 16)) & 0x0000FFFF0000FFFFull;
+            digits = (digits * 10000 + (digits >> 32)) & 0x00000000FFFFFFFFull;
+            return static_cast<int>(digits);
+        }
+    };
+
+    // Loads applications through ApplicantCsvParser; applicants are numbered by row from 1,
+    // so applicants tied on rank keep distinct IDs
+    class ApplicantLoader {
+    public:
+        static std::vector<CollegeApplication> load(const std::string& applicantFile) {
+            return load(MappedFile::open(applicantFile));
+        }
+
+        static std::vector<CollegeApplication> load(MappedFile applicantFile) {
+            ApplicantColumns columns = ApplicantCsvParser::parseFile(std::move(applicantFile));
+            std::vector<CollegeApplication> applications;
+            applications.reserve(columns.size());
+            for (size_t row = 0; row < columns.size(); ++row) {
+                applications.emplace_back(static_cast<int>(row + 1), columns.name(row), columns.ranks[row], std::string(columns.category(row)));
+            }
+            return applications;
+        }
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace CollegeCounseling {
+    // Index of the lowest set bit of a non-zero word
+    inline int countTrailingZeros(std::uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    // Finds structural bytes 64 at a time: each block yields a bitmask of matching bytes
+    // (AVX2 or SSE2 compares plus movemask), and set bits are peeled off with count-trailing-zeros.
+    // The final partial block is copied into a zero-padded buffer and scanned the same way.
+    class ByteScanner {
+    public:
+        // Bit i is set when block[i] == target; block must have 64 readable bytes
+        static std::uint64_t equalMask(const char* block, char target) {
+#if defined(__AVX2__)
+            __m256i needle = _mm256_set1_epi8(target);
+            std::uint32_t low = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), needle)));
+            std::uint32_t high = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)), needle)));
+            return (std::uint64_t(high) << 32) | low;
+#elif defined(__SSE2__) || defined(_M_X64)
+            __m128i needle = _mm_set1_epi8(target);
+            std::uint64_t mask = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                std::uint32_t bits = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * lane)), needle)));
+                mask |= std::uint64_t(bits) << (16 * lane);
+            }
+            return mask;
+#else
+            std::uint64_t mask = 0;
+            for (int i = 0; i < 64; ++i) {
+                mask |= std::uint64_t(block[i] == target) << i;
+            }
+            return mask;
+#endif
+        }
+
+        // Appends the offset of every byte equal to one of the targets, in one pass over the buffer
+        static void findAll(const char* data, size_t size, const std::string& targets, std::vector<size_t>& positions) {
+            size_t offset = 0;
+            for (; offset + 64 <= size; offset += 64) {
+                collect(data + offset, offset, targets, positions, ~std::uint64_t(0));
+            }
+            if (offset < size) {
+                char tail[64] = {};
+                std::memcpy(tail, data + offset, size - offset);
+                collect(tail, offset, targets, positions, (std::uint64_t(1) << (size - offset)) - 1);
+            }
+        }
+
+    private:
+        static void collect(const char* block, size_t offset, const std::string& targets, std::vector<size_t>& positions,
+                            std::uint64_t validBytes) {
+            std::uint64_t mask = 0;
+            for (char target : targets) {
+                mask |= equalMask(block, target);
+            }
+            mask &= validBytes;
+            while (mask != 0) {
+                positions.push_back(offset + static_cast<size_t>(countTrailingZeros(mask)));
+                mask &= mask - 1;
+            }
+        }
+    };
+
+    // Hints the CPU to pull a cache line in ahead of a read
+    inline void prefetchRead(const void* address) {
+#if defined(_MSC_VER)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(address, 0, 3);
+#endif
+    }
+
+    // Number of set bits in a word
+    inline int countSetBits(std::uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    // Position of the k-th (0-based) set bit of a word holding more than k set bits: one PDEP
+    // with BMI2, otherwise whole bytes are skipped by popcount before stepping bit by bit
+    inline int selectSetBit(std::uint64_t word, int k) {
+#if defined(__BMI2__)
+        return countTrailingZeros(_pdep_u64(std::uint64_t(1) << k, word));
+#else
+        int shift = 0;
+        for (int inByte = countSetBits(word & 0xFF); inByte <= k; inByte = countSetBits((word >> shift) & 0xFF)) {
+            k -= inByte;
+            shift += 8;
+        }
+        std::uint64_t rest = word >> shift;
+        for (; k > 0; --k) {
+            rest &= rest - 1;
+        }
+        return shift + countTrailingZeros(rest);
+#endif
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+
+#include "AllocationStrategy.h"
+
+namespace CollegeCounseling {
+    // Class representing a college application
+    class CollegeApplication {
+    private:
+        int applicantId;
+        std::string applicantName;
+        int applicantRank;
+        std::string applicantCategory;
+
+    public:
+        // Parameterized constructor for creating a college application
+        CollegeApplication(int id, const std::string& name, int rank, const std::string& category = "GM")
+            : applicantId(id), applicantName(name), applicantRank(rank), applicantCategory(category) {}
+
+        // Delegating constructor for the single applicant entered at the prompt, who gets ID 0;
+        // ranks may tie, so the rank is never used as an ID
+        CollegeApplication(const std::string& name, int rank)
+            : CollegeApplication(0, name, rank) {}
+
+        // Getter for the applicant's ID
+        int getApplicantId() const {
+            return applicantId;
+        }
+
+        // Getter for the applicant's name
+        std::string getApplicantName() const {
+            return applicantName;
+        }
+
+        // Getter for the applicant's rank
+        int getApplicantRank() const {
+            return applicantRank;
+        }
+
+        // Getter for the applicant's reservation category, "GM" (general merit) by default
+        const std::string& getApplicantCategory() const {
+            return applicantCategory;
+        }
+    };
+
+    // Class providing a static method for college allocation
+    class CollegeAdmissionSystem {
+    public:
+        // Static method to allocate a college based on a strategy and application
+        static std::string allocateCollege(const AllocationStrategy& strategy, const CollegeApplication& application) {
+            return strategy.allocateCollege(application.getApplicantRank());
+        }
+    };
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Header-only core of the counseling system: seat-matrix index, allocation strategies,
+// applicant loading, round pipeline, journaling, analytics and run configuration
+#include "AllocationStrategy.h"
+#include "Bits.h"
+#include "HugePages.h"
+#include "MappedFile.h"
+#include "CollegeNamePool.h"
+#include "CollegeNameHash.h"
+#include "RankCoverage.h"
+#include "SectionedSnapshot.h"
+#include "RankIntervalStrategy.h"
+#include "CollegeApplication.h"
+#include "CollegeSearchIndex.h"
+#include "AllocationJournal.h"
+#include "EmbeddedMatrix.h"
+#include "RoundDeltaStore.h"
+#include "Parallel.h"
+#include "RoundDiff.h"
+#include "CutoffAnalytics.h"
+#include "PhiloxRng.h"
+#include "Matching.h"
+#include "WhatIfSimulator.h"
+#include "ApplicantCsv.h"
+#include "RoundPipeline.h"
+#include "EliasFano.h"
+#include "CompressedIntervalIndex.h"
+#include "DatasetKey.h"
+#include "DatasetRegistry.h"
+#include "SeatMatrixSnapshot.h"
+#include "DynamicIntervalIndex.h"
+#include "CounselingConfig.h"
+#include "RoundStrategies.h"
+#include "SeatMatrixHistory.h"
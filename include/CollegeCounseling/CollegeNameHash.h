@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "Bits.h"
+
+namespace CollegeCounseling {
+    // Minimal perfect hash (BBHash-style cascade of collision-free bit arrays) from college
+    // name to college ID. Names are interned first, so a name listed under several intervals
+    // maps to its first ID. At each level a key hashes into a bit array twice the size of the
+    // keys still unplaced; keys that land alone keep that bit and the rest move to the next
+    // level. A key's slot is the rank of its bit, so the slot table is exactly as large as the
+    // key set. A 64-bit fingerprint plus a name compare rejects names not in the table.
+    class CollegeNameHash {
+    private:
+        static constexpr int maxLevels = 24;
+
+        std::vector<std::uint64_t> levelBits;
+        std::vector<size_t> levelOffsets;
+        std::vector<size_t> levelSizes;
+        std::vector<std::uint32_t> wordRanks;
+        std::vector<std::uint64_t> slotFingerprints;
+        std::vector<std::int32_t> slotIds;
+
+        // Name of each slot, viewing storage owned by the caller (the strategy's name pool)
+        std::vector<std::string_view> slotNames;
+
+        // Keys still colliding after the last level, expected to be empty or tiny
+        std::unordered_map<std::string, std::int32_t> overflow;
+
+    public:
+        // Builds the hash over names indexed by college ID; the names must outlive the hash
+        void build(const std::vector<std::string_view>& namesById) {
+            // Intern: sort by (hash, ID) and keep the first ID of every distinct name
+            std::vector<std::string_view> keysById(namesById.size());
+            std::vector<std::pair<std::uint64_t, std::int32_t>> byHash(namesById.size());
+            for (size_t id = 0; id < namesById.size(); ++id) {
+                keysById[id] = trim(namesById[id]);
+                byHash[id] = { hashKey(keysById[id]), static_cast<std::int32_t>(id) };
+            }
+            std::sort(byHash.begin(), byHash.end());
+            std::vector<std::uint64_t> hashes;
+            std::vector<std::int32_t> ids;
+            for (size_t i = 0; i < byHash.size(); ++i) {
+                bool duplicate = false;
+                for (size_t j = i; j > 0 && byHash[j - 1].first == byHash[i].first && !duplicate; --j) {
+                    duplicate = keysById[byHash[j - 1].second] == keysById[byHash[i].second];
+                }
+                if (!duplicate) {
+                    hashes.push_back(byHash[i].first);
+                    ids.push_back(byHash[i].second);
+                }
+            }
+
+            std::vector<size_t> remaining(hashes.size());
+            for (size_t k = 0; k < remaining.size(); ++k) {
+                remaining[k] = k;
+            }
+
+            levelBits.clear();
+            levelOffsets.clear();
+            levelSizes.clear();
+            overflow.clear();
+            std::vector<std::pair<size_t, size_t>> placed;
+            std::vector<std::uint64_t> seen, collided;
+            std::vector<size_t> next;
+            for (int level = 0; level < maxLevels && !remaining.empty(); ++level) {
+                size_t bitCount = (remaining.size() * 2 + 63) / 64 * 64;
+                seen.assign(bitCount / 64, 0);
+                collided.assign(bitCount / 64, 0);
+                for (size_t k : remaining) {
+                    size_t bit = levelPosition(hashes[k], level, bitCount);
+                    std::uint64_t flag = std::uint64_t(1) << (bit % 64);
+                    collided[bit / 64] |= seen[bit / 64] & flag;
+                    seen[bit / 64] |= flag;
+                }
+
+                size_t offset = levelBits.size() * 64;
+                levelOffsets.push_back(offset);
+                levelSizes.push_back(bitCount);
+                for (size_t w = 0; w < seen.size(); ++w) {
+                    levelBits.push_back(seen[w] & ~collided[w]);
+                }
+                next.clear();
+                for (size_t k : remaining) {
+                    size_t bit = levelPosition(hashes[k], level, bitCount);
+                    if (collided[bit / 64] & (std::uint64_t(1) << (bit % 64))) {
+                        next.push_back(k);
+                    } else {
+                        placed.emplace_back(offset + bit, k);
+                    }
+                }
+                remaining.swap(next);
+            }
+
+            wordRanks.resize(levelBits.size());
+            std::uint32_t rank = 0;
+            for (size_t w = 0; w < levelBits.size(); ++w) {
+                wordRanks[w] = rank;
+                rank += static_cast<std::uint32_t>(countSetBits(levelBits[w]));
+            }
+
+            slotFingerprints.assign(placed.size(), 0);
+            slotIds.assign(placed.size(), AllocationStrategy::noCollegeId);
+            std::sort(placed.begin(), placed.end());
+            slotNames.assign(placed.size(), std::string_view());
+            for (size_t slot = 0; slot < placed.size(); ++slot) {
+                size_t k = placed[slot].second;
+                slotFingerprints[slot] = hashes[k];
+                slotIds[slot] = ids[k];
+                slotNames[slot] = keysById[ids[k]];
+            }
+            for (size_t k : remaining) {
+                overflow.emplace(std::string(keysById[ids[k]]), ids[k]);
+            }
+        }
+
+        // College ID for a name, or noCollegeId when the name is not in the table
+        std::int32_t find(const std::string& name) const {
+            std::string_view key = trim(name);
+            std::uint64_t hash = hashKey(key);
+            for (size_t level = 0; level < levelSizes.size(); ++level) {
+                size_t bit = levelOffsets[level] + levelPosition(hash, static_cast<int>(level), levelSizes[level]);
+                if (levelBits[bit / 64] & (std::uint64_t(1) << (bit % 64))) {
+                    size_t slot = rankOf(bit);
+                    if (slotFingerprints[slot] != hash || slotNames[slot] != key) {
+                        return AllocationStrategy::noCollegeId;
+                    }
+                    return slotIds[slot];
+                }
+            }
+            auto found = overflow.find(std::string(key));
+            return found == overflow.end() ? AllocationStrategy::noCollegeId : found->second;
+        }
+
+        // Bytes held by the hash tables, excluding the names they view
+        size_t getMemoryBytes() const {
+            size_t bytes = levelBits.capacity() * sizeof(std::uint64_t) + (levelOffsets.capacity() + levelSizes.capacity()) * sizeof(size_t)
+                         + wordRanks.capacity() * sizeof(std::uint32_t) + slotFingerprints.capacity() * sizeof(std::uint64_t)
+                         + slotIds.capacity() * sizeof(std::int32_t) + slotNames.capacity() * sizeof(std::string_view);
+            for (const auto& entry : overflow) {
+                bytes += sizeof(entry) + entry.first.capacity();
+            }
+            return bytes;
+        }
+
+    private:
+        // Number of set bits before a global bit position
+        size_t rankOf(size_t bit) const {
+            std::uint64_t below = levelBits[bit / 64] & ((std::uint64_t(1) << (bit % 64)) - 1);
+            return wordRanks[bit / 64] + static_cast<size_t>(countSetBits(below));
+        }
+
+        // Re-mixes the key hash per level so every level is an independent hash function
+        static size_t levelPosition(std::uint64_t hash, int level, size_t bitCount) {
+            std::uint64_t mixed = hash ^ (static_cast<std::uint64_t>(level + 1) * 0x9E3779B97F4A7C15ull);
+            mixed ^= mixed >> 31;
+            mixed *= 0xbf58476d1ce4e5b9ull;
+            mixed ^= mixed >> 29;
+            return static_cast<size_t>(mixed % bitCount);
+        }
+
+        // FNV-1a 64 folded through a murmur finalizer
+        static std::uint64_t hashKey(std::string_view key) {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (unsigned char c : key) {
+                hash = (hash ^ c) * 1099511628211ull;
+            }
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        static std::string_view trim(std::string_view text) {
+            size_t first = text.find_first_not_of(" \t\r\n");
+            if (first == std::string_view::npos) {
+                return std::string_view();
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+        }
+    };
+}
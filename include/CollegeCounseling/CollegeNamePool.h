@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CollegeCounseling {
+    // Thread-safe intern pool for college names. Every distinct name is stored once and the
+    // returned reference stays valid for the pool's lifetime, so seat matrices sharing a pool
+    // share the storage of repeated names. Names are never removed: the pool holds the union of
+    // every table loaded into it, which stays small because names repeat across tables.
+    // The index is an open-addressing table of (hash, name) slots kept at most half full.
+    class CollegeNamePool {
+    private:
+        mutable std::mutex mutex;
+        // Stored names; deque elements never move
+        std::deque<std::string> names;
+        std::vector<std::uint64_t> slotHashes;
+        std::vector<const std::string*> slots;
+        size_t storedBytes = 0;
+
+    public:
+        const std::string& intern(std::string_view name) {
+            std::lock_guard<std::mutex> lock(mutex);
+            reserveSlots(names.size() + 1);
+            return *insert(name);
+        }
+
+        // Interns a whole table under one lock; pooled[i] receives the stored copy of batch[i]
+        void internAll(const std::vector<std::string_view>& batch, std::vector<const std::string*>& pooled) {
+            std::lock_guard<std::mutex> lock(mutex);
+            reserveSlots(names.size() + batch.size());
+            pooled.resize(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                pooled[i] = insert(batch[i]);
+            }
+        }
+
+        size_t getNameCount() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return names.size();
+        }
+
+        // Characters stored, not counting per-name overhead
+        size_t getStoredBytes() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return storedBytes;
+        }
+
+    private:
+        const std::string* insert(std::string_view name) {
+            std::uint64_t hash = std::hash<std::string_view>()(name);
+            size_t mask = slots.size() - 1;
+            for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+                if (!slots[slot]) {
+                    names.emplace_back(name);
+                    storedBytes += name.size();
+                    slotHashes[slot] = hash;
+                    slots[slot] = &names.back();
+                    return slots[slot];
+                }
+                if (slotHashes[slot] == hash && *slots[slot] == name) {
+                    return slots[slot];
+                }
+            }
+        }
+
+        // Grows the table so it stays at most half full with the given number of names
+        void reserveSlots(size_t nameCount) {
+            size_t capacity = 16;
+            while (capacity < nameCount * 2) {
+                capacity *= 2;
+            }
+            if (capacity <= slots.size()) {
+                return;
+            }
+            std::vector<std::uint64_t> oldHashes(capacity, 0);
+            std::vector<const std::string*> oldSlots(capacity, nullptr);
+            oldHashes.swap(slotHashes);
+            oldSlots.swap(slots);
+            size_t mask = capacity - 1;
+            for (size_t i = 0; i < oldSlots.size(); ++i) {
+                if (oldSlots[i]) {
+                    size_t slot = static_cast<size_t>(oldHashes[i]) & mask;
+                    while (slots[slot]) {
+                        slot = (slot + 1) & mask;
+                    }
+                    slotHashes[slot] = oldHashes[i];
+                    slots[slot] = oldSlots[i];
+                }
+            }
+        }
+    };
+}
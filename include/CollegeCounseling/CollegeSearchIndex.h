@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Search over college names: a trigram inverted index with delta+varint compressed posting
+    // lists, plus a facet index on the city (the text after the last comma of each name).
+    // Trigrams narrow the candidates; a substring check on the normalized name confirms them.
+    class CollegeSearchIndex {
+    private:
+        // Normalized names: lowercase letters and digits, runs of anything else become one space
+        std::vector<std::string> normalizedNames;
+
+        // Trigram keys sorted ascending, each owning a slice of postingBytes
+        std::vector<std::uint32_t> trigramKeys;
+        std::vector<std::uint32_t> postingOffsets;
+        std::vector<std::uint32_t> postingCounts;
+        std::vector<std::uint8_t> postingBytes;
+
+        // City facet, normalized city -> ascending college IDs
+        std::unordered_map<std::string, std::vector<std::int32_t>> cityFacet;
+
+    public:
+        explicit CollegeSearchIndex(const RankIntervalStrategy& index) {
+            std::vector<std::pair<std::uint32_t, std::int32_t>> pairs;
+            for (int id = 0; id < index.getCollegeCount(); ++id) {
+                const std::string& name = index.getCollegeName(id);
+                normalizedNames.push_back(normalize(name));
+                const std::string& normalized = normalizedNames.back();
+                for (size_t i = 0; i + 3 <= normalized.size(); ++i) {
+                    pairs.emplace_back(trigramKey(normalized.data() + i), id);
+                }
+
+                size_t commaPos = name.rfind(',');
+                if (commaPos != std::string::npos) {
+                    cityFacet[normalize(name.substr(commaPos + 1))].push_back(id);
+                }
+            }
+
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+            for (size_t i = 0; i < pairs.size();) {
+                trigramKeys.push_back(pairs[i].first);
+                postingOffsets.push_back(static_cast<std::uint32_t>(postingBytes.size()));
+                std::int32_t previous = 0;
+                size_t count = 0;
+                for (; i < pairs.size() && pairs[i].first == trigramKeys.back(); ++i, ++count) {
+                    putVarint(static_cast<std::uint32_t>(pairs[i].second - previous));
+                    previous = pairs[i].second;
+                }
+                postingCounts.push_back(static_cast<std::uint32_t>(count));
+            }
+        }
+
+        // IDs of colleges whose name contains the query (case and punctuation insensitive),
+        // optionally restricted to one city
+        std::vector<std::int32_t> search(const std::string& query, const std::string& city = "") const {
+            std::string needle = normalize(query);
+            std::vector<std::int32_t> candidates;
+
+            if (needle.size() < 3) {
+                for (size_t id = 0; id < normalizedNames.size(); ++id) {
+                    candidates.push_back(static_cast<std::int32_t>(id));
+                }
+            } else {
+                // Intersect postings rarest first so the candidate set shrinks quickly
+                std::vector<size_t> slots;
+                for (size_t i = 0; i + 3 <= needle.size(); ++i) {
+                    auto found = std::lower_bound(trigramKeys.begin(), trigramKeys.end(), trigramKey(needle.data() + i));
+                    if (found == trigramKeys.end() || *found != trigramKey(needle.data() + i)) {
+                        return {};
+                    }
+                    slots.push_back(static_cast<size_t>(found - trigramKeys.begin()));
+                }
+                std::sort(slots.begin(), slots.end(), [this](size_t a, size_t b) { return postingCounts[a] < postingCounts[b]; });
+                slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+                decodePostings(slots.front(), candidates);
+                std::vector<std::int32_t> postings, kept;
+                for (size_t k = 1; k < slots.size() && !candidates.empty(); ++k) {
+                    decodePostings(slots[k], postings);
+                    kept.clear();
+                    std::set_intersection(candidates.begin(), candidates.end(), postings.begin(), postings.end(), std::back_inserter(kept));
+                    candidates.swap(kept);
+                }
+            }
+
+            if (!city.empty()) {
+                const std::vector<std::int32_t>& inCity = findByCity(city);
+                std::vector<std::int32_t> kept;
+                std::set_intersection(candidates.begin(), candidates.end(), inCity.begin(), inCity.end(), std::back_inserter(kept));
+                candidates.swap(kept);
+            }
+
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](std::int32_t id) {
+                return normalizedNames[id].find(needle) == std::string::npos;
+            }), candidates.end());
+            return candidates;
+        }
+
+        // IDs of every college in a city
+        const std::vector<std::int32_t>& findByCity(const std::string& city) const {
+            static const std::vector<std::int32_t> none;
+            auto found = cityFacet.find(normalize(city));
+            return found == cityFacet.end() ? none : found->second;
+        }
+
+    private:
+        static std::string normalize(const std::string& text) {
+            std::string normalized;
+            normalized.reserve(text.size());
+            bool pendingSpace = false;
+            for (unsigned char c : text) {
+                if (std::isalnum(c)) {
+                    if (pendingSpace && !normalized.empty()) {
+                        normalized.push_back(' ');
+                    }
+                    normalized.push_back(static_cast<char>(std::tolower(c)));
+                    pendingSpace = false;
+                } else {
+                    pendingSpace = true;
+                }
+            }
+            return normalized;
+        }
+
+        static std::uint32_t trigramKey(const char* text) {
+            return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[0])) << 16)
+                 | (static_cast<std::uint32_t>(static_cast<unsigned char>(text[1])) << 8)
+                 | static_cast<unsigned char>(text[2]);
+        }
+
+        void putVarint(std::uint32_t value) {
+            while (value >= 0x80) {
+                postingBytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            postingBytes.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        void decodePostings(size_t slot, std::vector<std::int32_t>& out) const {
+            out.resize(postingCounts[slot]);
+            const std::uint8_t* cursor = postingBytes.data() + postingOffsets[slot];
+            std::int32_t value = 0;
+            for (std::int32_t& id : out) {
+                std::uint32_t delta = 0;
+                int shift = 0;
+                std::uint8_t byte;
+                do {
+                    byte = *cursor++;
+                    delta |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                    shift += 7;
+                } while (byte >= 0x80);
+                value += static_cast<std::int32_t>(delta);
+                id = value;
+            }
+        }
+    };
+}
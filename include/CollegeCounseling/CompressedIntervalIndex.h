@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "CollegeNamePool.h"
+#include "EliasFano.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Read-only seat matrix answering lookups straight from a succinct form of the segment
+    // index, for keeping many boards and years resident at once. Segment boundaries (every
+    // rankStart and rankEnd + 1 that changes the owner) are Elias-Fano encoded relative to the
+    // first one, and segment owners are bit-packed at the width the college count needs. A
+    // lookup is a predecessor count on the boundaries plus one packed read. Names stay in the
+    // source table's pool, which the index keeps alive.
+    class CompressedIntervalIndex : public AllocationStrategy {
+    private:
+        std::shared_ptr<CollegeNamePool> namePool;
+        std::vector<const std::string*> names;
+        std::uint32_t snapshotVersion = 0;
+
+        // Smallest boundary; boundaries are stored as offsets from it
+        std::int64_t base = 0;
+        EliasFanoSequence boundaries;
+        // Owner of each segment plus one, 0 for gaps
+        PackedIntArray owners;
+
+    public:
+        // Compresses a loaded table; the table itself can be released afterwards
+        explicit CompressedIntervalIndex(const RankIntervalStrategy& table)
+            : namePool(table.getNamePool()), snapshotVersion(table.getSnapshotVersion()) {
+            names.reserve(static_cast<size_t>(table.getCollegeCount()));
+            for (int id = 0; id < table.getCollegeCount(); ++id) {
+                names.push_back(&table.getCollegeName(id));
+            }
+
+            const HugeVector<int>& starts = table.getSegmentStarts();
+            const HugeVector<std::int32_t>& ids = table.getSegmentIds();
+            std::vector<std::uint64_t> offsets(starts.size());
+            base = starts.empty() ? 0 : starts.front();
+            for (size_t k = 0; k < starts.size(); ++k) {
+                offsets[k] = static_cast<std::uint64_t>(static_cast<std::int64_t>(starts[k]) - base);
+            }
+            boundaries.build(offsets);
+            owners = PackedIntArray(ids.size(), PackedIntArray::bitsFor(names.size()));
+            for (size_t k = 0; k < ids.size(); ++k) {
+                owners.set(k, static_cast<std::uint64_t>(ids[k] + 1));
+            }
+        }
+
+        std::string allocateCollege(int userRank) const override {
+            int collegeId = allocateCollegeId(userRank);
+            if (collegeId == noCollegeId) {
+                return "No college allocated for your rank.";
+            }
+            return *names[static_cast<size_t>(collegeId)];
+        }
+
+        int allocateCollegeId(int userRank) const override {
+            if (userRank < base) {
+                return noCollegeId;
+            }
+            size_t segments = boundaries.countAtMost(static_cast<std::uint64_t>(static_cast<std::int64_t>(userRank) - base));
+            if (segments == 0) {
+                return noCollegeId;
+            }
+            return static_cast<int>(owners.get(segments - 1)) - 1;
+        }
+
+        int getCollegeCount() const {
+            return static_cast<int>(names.size());
+        }
+
+        const std::string& getCollegeName(int collegeId) const {
+            return *names.at(static_cast<size_t>(collegeId));
+        }
+
+        std::uint32_t getSnapshotVersion() const {
+            return snapshotVersion;
+        }
+
+        size_t getSegmentCount() const {
+            return boundaries.size();
+        }
+
+        // Bytes of the encoded boundaries and owners
+        size_t getBoundaryBytes() const {
+            return boundaries.getMemoryBytes() + owners.getMemoryBytes();
+        }
+
+        // Bytes the same segments take as plain int arrays
+        size_t getPlainBoundaryBytes() const {
+            return boundaries.size() * (sizeof(int) + sizeof(std::int32_t));
+        }
+
+        // Bytes held by this index, excluding the (possibly shared) name pool
+        size_t getIndexBytes() const {
+            return getBoundaryBytes() + names.capacity() * sizeof(const std::string*);
+        }
+    };
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "DatasetKey.h"
+
+namespace CollegeCounseling {
+    // Dataset locations for a run, resolved once at startup. counseling.conf (or the file named
+    // by COUNSELING_CONFIG) holds "key = value" lines; blank, '#' and "//" lines are ignored and
+    // relative paths are taken from the config file's directory:
+    //   seat_matrix = project.txt          round 1 seat matrix
+    //   seat_matrix.N = round2.txt         seat matrix replacing the default strategy of round N
+    //   applicants = applicants.csv        applicant source when the command line names none
+    //   journal, checkpoint, results       where batch runs keep their snapshots
+    //   dataset.BOARD.YEAR.ROUND = file    seat matrix served through the dataset registry
+    //   dataset_memory_mb = 256            registry budget for loaded dataset indexes
+    //   dataset_index = compressed         registry keeps Elias-Fano indexes ("plain" by default)
+    // Without a config file the legacy data.txt, a single seat-matrix path, is read instead.
+    class CounselingConfig {
+    public:
+        // Seat matrix per round (index 0 is round 1); an empty path keeps the default strategy
+        std::vector<std::string> seatMatrices;
+        std::string applicantFile;
+        std::string journalPath = "allocation_journal.bin";
+        std::string checkpointPath = "round_checkpoint.bin";
+        std::string resultsPath = "round_results.bin";
+        // Registry datasets and their seat-matrix files
+        std::vector<std::pair<DatasetKey, std::string>> datasets;
+        size_t datasetMemoryBudget = size_t(256) << 20;
+        DatasetIndex datasetIndex = DatasetIndex::Plain;
+
+        // Resolves the configuration the CLI runs with
+        static CounselingConfig load() {
+            const char* configured = std::getenv("COUNSELING_CONFIG");
+            if (configured && *configured) {
+                return loadFile(configured);
+            }
+            if (fileExists("counseling.conf")) {
+                return loadFile("counseling.conf");
+            }
+            if (fileExists("data.txt")) {
+                return loadLegacy("data.txt");
+            }
+            throw std::runtime_error("Error: Cannot find counseling.conf or data.txt");
+        }
+
+        static CounselingConfig loadFile(const std::string& configFile) {
+            std::ifstream file(configFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Error: Cannot open " + configFile);
+            }
+            std::string directory = directoryOf(configFile);
+            CounselingConfig config;
+            std::string line;
+            while (std::getline(file, line)) {
+                std::string entry = trim(line);
+                if (entry.empty() || entry[0] == '#' || entry.compare(0, 2, "//") == 0) {
+                    continue;
+                }
+                size_t equals = entry.find('=');
+                if (equals == std::string::npos) {
+                    throw std::runtime_error("Error: Invalid line in " + configFile + ": " + entry);
+                }
+                std::string key = trim(entry.substr(0, equals));
+                std::string value = resolve(directory, unquote(trim(entry.substr(equals + 1))));
+                if (key == "seat_matrix") {
+                    config.setSeatMatrix(1, value);
+                } else if (key.compare(0, 12, "seat_matrix.") == 0) {
+                    config.setSeatMatrix(roundNumber(key.substr(12), configFile), value);
+                } else if (key == "applicants") {
+                    config.applicantFile = value;
+                } else if (key == "journal") {
+                    config.journalPath = value;
+                } else if (key == "checkpoint") {
+                    config.checkpointPath = value;
+                } else if (key == "results") {
+                    config.resultsPath = value;
+                } else if (key.compare(0, 8, "dataset.") == 0) {
+                    config.datasets.emplace_back(datasetKey(key.substr(8), configFile), value);
+                } else if (key == "dataset_index") {
+                    config.datasetIndex = indexKind(unquote(trim(entry.substr(equals + 1))), configFile);
+                } else if (key == "dataset_memory_mb") {
+                    config.datasetMemoryBudget = static_cast<size_t>(roundNumber(unquote(trim(entry.substr(equals + 1))), configFile)) << 20;
+                } else {
+                    throw std::runtime_error("Error: Unknown setting " + key + " in " + configFile);
+                }
+            }
+            if (config.seatMatrix(1).empty() && config.datasets.empty()) {
+                throw std::runtime_error("Error: " + configFile + " sets no seat_matrix or dataset");
+            }
+            return config;
+        }
+
+        // Reads a data.txt holding one seat-matrix path. A path that does not exist here (such as
+        // one written on another machine) falls back to project.txt beside data.txt.
+        static CounselingConfig loadLegacy(const std::string& pathFile) {
+            std::ifstream file(pathFile);
+            if (!file.is_open()) {
+                throw std::runtime_error("Error: Cannot open " + pathFile);
+            }
+            std::string line;
+            std::getline(file, line);
+            std::string directory = directoryOf(pathFile);
+            std::string seatMatrix = resolve(directory, unquote(trim(line)));
+            if (!fileExists(seatMatrix)) {
+                seatMatrix = resolve(directory, "project.txt");
+            }
+            CounselingConfig config;
+            config.setSeatMatrix(1, seatMatrix);
+            return config;
+        }
+
+        // Seat matrix of a 1-based round, empty when the round has none
+        const std::string& seatMatrix(size_t round) const {
+            static const std::string none;
+            return round >= 1 && round <= seatMatrices.size() ? seatMatrices[round - 1] : none;
+        }
+
+        void setSeatMatrix(size_t round, const std::string& path) {
+            if (seatMatrices.size() < round) {
+                seatMatrices.resize(round);
+            }
+            seatMatrices[round - 1] = path;
+        }
+
+    private:
+        static bool fileExists(const std::string& path) {
+#ifdef _WIN32
+            struct _stat64 info;
+            return ::_stat64(path.c_str(), &info) == 0;
+#else
+            struct stat info;
+            return ::stat(path.c_str(), &info) == 0;
+#endif
+        }
+
+        static std::string trim(const std::string& text) {
+            size_t first = text.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) {
+                return "";
+            }
+            return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+        }
+
+        static std::string unquote(const std::string& text) {
+            if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+                return text.substr(1, text.size() - 2);
+            }
+            return text;
+        }
+
+        static std::string directoryOf(const std::string& path) {
+            size_t separator = path.find_last_of("/\\");
+            return separator == std::string::npos ? "" : path.substr(0, separator + 1);
+        }
+
+        // Joins a relative path onto the config directory; absolute and drive paths are kept
+        static std::string resolve(const std::string& directory, const std::string& path) {
+            bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() >= 2 && path[1] == ':'));
+            return absolute || path.empty() ? path : directory + path;
+        }
+
+        // Positive number of at most six digits (rounds, years, megabytes)
+        static size_t roundNumber(const std::string& text, const std::string& configFile) {
+            size_t number = 0;
+            for (char c : text) {
+                if (c < '0' || c > '9' || number > 99999) {
+                    number = 0;
+                    break;
+                }
+                number = number * 10 + static_cast<size_t>(c - '0');
+            }
+            if (number == 0) {
+                throw std::runtime_error("Error: Invalid number " + text + " in " + configFile);
+            }
+            return number;
+        }
+
+        // Parses "BOARD.YEAR.ROUND"; the board name may itself contain dots
+        static DatasetKey datasetKey(const std::string& text, const std::string& configFile) {
+            size_t roundDot = text.rfind('.');
+            size_t yearDot = roundDot == std::string::npos || roundDot == 0 ? std::string::npos : text.rfind('.', roundDot - 1);
+            if (yearDot == std::string::npos || yearDot == 0) {
+                throw std::runtime_error("Error: Dataset keys are dataset.BOARD.YEAR.ROUND in " + configFile);
+            }
+            return { text.substr(0, yearDot), static_cast<int>(roundNumber(text.substr(yearDot + 1, roundDot - yearDot - 1), configFile)),
+                     static_cast<int>(roundNumber(text.substr(roundDot + 1), configFile)) };
+        }
+
+        static DatasetIndex indexKind(const std::string& text, const std::string& configFile) {
+            if (text == "plain") {
+                return DatasetIndex::Plain;
+            }
+            if (text == "compressed") {
+                return DatasetIndex::Compressed;
+            }
+            throw std::runtime_error("Error: dataset_index must be plain or compressed in " + configFile);
+        }
+    };
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CollegeApplication.h"
+#include "Parallel.h"
+
+namespace CollegeCounseling {
+    // Cutoff and seat-fill figures for one college in one round
+    struct CollegeCutoff {
+        int openingRank = 0;
+        int closingRank = 0;
+        std::int64_t seatsFilled = 0;
+        std::vector<std::int64_t> seatsByCategory;
+        std::vector<std::int64_t> rankHistogram;
+    };
+
+    // Result of an analytics pass; colleges are indexed by RankIntervalStrategy college ID
+    struct CutoffReport {
+        std::vector<std::string> categories;
+        std::vector<CollegeCutoff> colleges;
+        int histogramBuckets = 0;
+    };
+
+    // Computes opening/closing ranks, per-category fill and rank histograms for a round.
+    // Each worker aggregates its chunk of applicants into a private partial (with its own
+    // category numbering) and the partials are merged once at the end. Categories are reported
+    // in sorted order, so the output does not depend on the worker count.
+    class CutoffAnalytics {
+    private:
+        struct Partial {
+            std::vector<int> openingRank;
+            std::vector<int> closingRank;
+            std::vector<std::int64_t> seatsFilled;
+            std::vector<std::string> categories;
+            std::vector<std::vector<std::int64_t>> seatsByCategory;
+        };
+
+    public:
+        static CutoffReport compute(const std::vector<CollegeApplication>& applications, const std::vector<std::int32_t>& result,
+                                    int collegeCount, int histogramBuckets = 10, unsigned workerCount = 0) {
+            if (applications.size() != result.size()) {
+                throw std::runtime_error("Error: Round result does not match the applicant set.");
+            }
+            if (workerCount == 0) {
+                workerCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            size_t colleges = static_cast<size_t>(collegeCount);
+            histogramBuckets = std::max(1, histogramBuckets);
+
+            // Pass one: opening/closing ranks and seat counts
+            std::vector<Partial> partials(workerCount);
+            runInParallel(applications.size(), workerCount, [&](size_t begin, size_t end, unsigned worker) {
+                Partial& partial = partials[worker];
+                partial.openingRank.assign(colleges, std::numeric_limits<int>::max());
+                partial.closingRank.assign(colleges, std::numeric_limits<int>::min());
+                partial.seatsFilled.assign(colleges, 0);
+                std::unordered_map<std::string, size_t> categoryIndex;
+                for (size_t i = begin; i < end; ++i) {
+                    std::int32_t collegeId = result[i];
+                    if (collegeId < 0 || static_cast<size_t>(collegeId) >= colleges) {
+                        continue;
+                    }
+                    int rank = applications[i].getApplicantRank();
+                    partial.openingRank[collegeId] = std::min(partial.openingRank[collegeId], rank);
+                    partial.closingRank[collegeId] = std::max(partial.closingRank[collegeId], rank);
+                    ++partial.seatsFilled[collegeId];
+
+                    const std::string& category = applications[i].getApplicantCategory();
+                    auto found = categoryIndex.find(category);
+                    if (found == categoryIndex.end()) {
+                        found = categoryIndex.emplace(category, partial.categories.size()).first;
+                        partial.categories.push_back(category);
+                        partial.seatsByCategory.emplace_back(colleges, 0);
+                    }
+                    ++partial.seatsByCategory[found->second][collegeId];
+                }
+            });
+
+            CutoffReport report;
+            report.histogramBuckets = histogramBuckets;
+            report.colleges.resize(colleges);
+            for (CollegeCutoff& cutoff : report.colleges) {
+                cutoff.openingRank = std::numeric_limits<int>::max();
+                cutoff.closingRank = std::numeric_limits<int>::min();
+                cutoff.rankHistogram.assign(static_cast<size_t>(histogramBuckets), 0);
+            }
+            std::unordered_map<std::string, size_t> categoryIndex;
+            for (const Partial& partial : partials) {
+                for (size_t c = 0; c < partial.openingRank.size(); ++c) {
+                    report.colleges[c].openingRank = std::min(report.colleges[c].openingRank, partial.openingRank[c]);
+                    report.colleges[c].closingRank = std::max(report.colleges[c].closingRank, partial.closingRank[c]);
+                    report.colleges[c].seatsFilled += partial.seatsFilled[c];
+                }
+                for (size_t local = 0; local < partial.categories.size(); ++local) {
+                    auto found = categoryIndex.emplace(partial.categories[local], report.categories.size()).first;
+                    if (found->second == report.categories.size()) {
+                        report.categories.push_back(partial.categories[local]);
+                        for (CollegeCutoff& cutoff : report.colleges) {
+                            cutoff.seatsByCategory.push_back(0);
+                        }
+                    }
+                    for (size_t c = 0; c < colleges; ++c) {
+                        report.colleges[c].seatsByCategory[found->second] += partial.seatsByCategory[local][c];
+                    }
+                }
+            }
+
+            // Worker numbering follows which chunk saw a category first; sort it away
+            std::vector<size_t> categoryOrder(report.categories.size());
+            for (size_t k = 0; k < categoryOrder.size(); ++k) {
+                categoryOrder[k] = k;
+            }
+            std::sort(categoryOrder.begin(), categoryOrder.end(),
+                      [&report](size_t a, size_t b) { return report.categories[a] < report.categories[b]; });
+            std::vector<std::string> sortedCategories;
+            for (size_t k : categoryOrder) {
+                sortedCategories.push_back(report.categories[k]);
+            }
+            report.categories = std::move(sortedCategories);
+            for (CollegeCutoff& cutoff : report.colleges) {
+                std::vector<std::int64_t> sortedSeats;
+                for (size_t k : categoryOrder) {
+                    sortedSeats.push_back(cutoff.seatsByCategory[k]);
+                }
+                cutoff.seatsByCategory = std::move(sortedSeats);
+            }
+
+            // Pass two: histograms over each college's own [opening, closing] band
+            std::vector<std::vector<std::int64_t>> histograms(workerCount);
+            runInParallel(applications.size(), workerCount, [&](size_t begin, size_t end, unsigned worker) {
+                std::vector<std::int64_t>& histogram = histograms[worker];
+                histogram.assign(colleges * static_cast<size_t>(histogramBuckets), 0);
+                for (size_t i = begin; i < end; ++i) {
+                    std::int32_t collegeId = result[i];
+                    if (collegeId < 0 || static_cast<size_t>(collegeId) >= colleges) {
+                        continue;
+                    }
+                    const CollegeCutoff& cutoff = report.colleges[collegeId];
+                    std::int64_t span = static_cast<std::int64_t>(cutoff.closingRank) - cutoff.openingRank + 1;
+                    std::int64_t bucket = (applications[i].getApplicantRank() - static_cast<std::int64_t>(cutoff.openingRank)) * histogramBuckets / span;
+                    ++histogram[static_cast<size_t>(collegeId) * histogramBuckets + static_cast<size_t>(bucket)];
+                }
+            });
+            for (const std::vector<std::int64_t>& histogram : histograms) {
+                for (size_t c = 0; c < colleges && !histogram.empty(); ++c) {
+                    for (int b = 0; b < histogramBuckets; ++b) {
+                        report.colleges[c].rankHistogram[b] += histogram[c * histogramBuckets + b];
+                    }
+                }
+            }
+
+            // Colleges nobody joined report zero ranks
+            for (CollegeCutoff& cutoff : report.colleges) {
+                if (cutoff.seatsFilled == 0) {
+                    cutoff.openingRank = 0;
+                    cutoff.closingRank = 0;
+                }
+            }
+            return report;
+        }
+    };
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <tuple>
+
+namespace CollegeCounseling {
+    // Identifies one seat matrix among those served by a process
+    struct DatasetKey {
+        std::string board;
+        int year;
+        int round;
+
+        bool operator<(const DatasetKey& other) const {
+            return std::tie(board, year, round) < std::tie(other.board, other.year, other.round);
+        }
+
+        std::string toString() const {
+            return board + " " + std::to_string(year) + " round " + std::to_string(round);
+        }
+    };
+
+    // Index a registry keeps for each loaded dataset
+    enum class DatasetIndex {
+        // RankIntervalStrategy, with its name lookup and a dense table where one fits the budget
+        Plain,
+        // CompressedIntervalIndex, several times smaller, for keeping many years resident
+        Compressed
+    };
+}
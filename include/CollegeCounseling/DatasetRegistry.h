@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "AllocationStrategy.h"
+#include "CollegeNamePool.h"
+#include "CompressedIntervalIndex.h"
+#include "DatasetKey.h"
+#include "MappedFile.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Seat matrices of many boards, years and rounds in one process. A dataset is loaded on its
+    // first query into a name pool shared by all datasets, and the least recently used datasets
+    // are dropped once the loaded indexes exceed the memory budget (names stay in the pool).
+    // Callers hold a shared_ptr, so a dataset evicted while in use lives until they release it.
+    // Dense tables count against the budget like any other index, and each is capped at
+    // denseBudgetShare of it, so a single small-domain table cannot crowd out the rest.
+    class DatasetRegistry {
+    private:
+        struct Dataset {
+            std::string path;
+            std::shared_ptr<const AllocationStrategy> strategy;
+            size_t indexBytes = 0;
+            std::list<DatasetKey>::iterator recentPosition;
+            // Serializes loading of this dataset without blocking queries on others
+            std::mutex loadMutex;
+        };
+
+        size_t memoryBudget;
+        DatasetIndex indexKind;
+        std::shared_ptr<CollegeNamePool> namePool;
+
+        mutable std::mutex mutex;
+        std::map<DatasetKey, Dataset> datasets;
+        // Loaded datasets, most recently used first
+        std::list<DatasetKey> recentlyUsed;
+        size_t residentBytes = 0;
+
+    public:
+        // Fraction of the budget one plain dataset's dense table may take (1 / denseBudgetShare)
+        static constexpr size_t denseBudgetShare = 16;
+
+        // memoryBudgetBytes bounds the loaded indexes (the shared name pool is not counted)
+        explicit DatasetRegistry(size_t memoryBudgetBytes, DatasetIndex index = DatasetIndex::Plain,
+                                 std::shared_ptr<CollegeNamePool> names = nullptr)
+            : memoryBudget(memoryBudgetBytes), indexKind(index), namePool(names ? std::move(names) : std::make_shared<CollegeNamePool>()) {}
+
+        DatasetRegistry(const DatasetRegistry&) = delete;
+        DatasetRegistry& operator=(const DatasetRegistry&) = delete;
+
+        // Registers a seat-matrix file under a key; nothing is read until the first query
+        void add(const DatasetKey& key, const std::string& seatMatrixPath) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (datasets.count(key)) {
+                throw std::runtime_error("Error: Dataset registered twice: " + key.toString());
+            }
+            datasets[key].path = seatMatrixPath;
+        }
+
+        // Strategy of a dataset, loading it on first use and evicting others past the budget
+        std::shared_ptr<const AllocationStrategy> get(const DatasetKey& key) {
+            Dataset* dataset;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto found = datasets.find(key);
+                if (found == datasets.end()) {
+                    throw std::runtime_error("Error: Unknown dataset " + key.toString());
+                }
+                dataset = &found->second;
+                if (dataset->strategy) {
+                    recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, dataset->recentPosition);
+                    return dataset->strategy;
+                }
+            }
+
+            std::lock_guard<std::mutex> loading(dataset->loadMutex);
+            {
+                // Another thread may have finished loading while this one waited
+                std::lock_guard<std::mutex> lock(mutex);
+                if (dataset->strategy) {
+                    recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, dataset->recentPosition);
+                    return dataset->strategy;
+                }
+            }
+            std::shared_ptr<const AllocationStrategy> strategy;
+            size_t indexBytes;
+            // The compressed index never reads the dense table, so it is not built for it
+            std::int64_t denseRanks = indexKind == DatasetIndex::Compressed
+                                          ? 0
+                                          : static_cast<std::int64_t>(memoryBudget / denseBudgetShare / sizeof(std::int32_t));
+            auto table = std::make_shared<const RankIntervalStrategy>(MappedFile::open(dataset->path), namePool, denseRanks);
+            if (indexKind == DatasetIndex::Compressed) {
+                // The parsed table is only needed while compressing
+                auto compressed = std::make_shared<const CompressedIntervalIndex>(*table);
+                indexBytes = compressed->getIndexBytes();
+                strategy = compressed;
+            } else {
+                indexBytes = table->getIndexBytes();
+                strategy = table;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            dataset->strategy = strategy;
+            dataset->indexBytes = indexBytes;
+            residentBytes += dataset->indexBytes;
+            recentlyUsed.push_front(key);
+            dataset->recentPosition = recentlyUsed.begin();
+            evictOverBudget();
+            return strategy;
+        }
+
+        // College ID for a rank in one dataset
+        int allocateCollegeId(const DatasetKey& key, int userRank) {
+            return get(key)->allocateCollegeId(userRank);
+        }
+
+        bool isLoaded(const DatasetKey& key) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = datasets.find(key);
+            return found != datasets.end() && found->second.strategy != nullptr;
+        }
+
+        size_t getLoadedCount() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return recentlyUsed.size();
+        }
+
+        // Bytes of the loaded indexes counted against the budget
+        size_t getResidentBytes() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return residentBytes;
+        }
+
+        const CollegeNamePool& getNamePool() const {
+            return *namePool;
+        }
+
+    private:
+        // Drops least recently used datasets until the budget holds, always keeping the newest
+        void evictOverBudget() {
+            while (residentBytes > memoryBudget && recentlyUsed.size() > 1) {
+                Dataset& victim = datasets.find(recentlyUsed.back())->second;
+                residentBytes -= victim.indexBytes;
+                victim.indexBytes = 0;
+                victim.strategy.reset();
+                recentlyUsed.pop_back();
+            }
+        }
+    };
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "AllocationStrategy.h"
+#include "RankIntervalStrategy.h"
+#include "SeatMatrixSnapshot.h"
+
+namespace CollegeCounseling {
+    // Seat matrix that takes interval corrections (a changed range, a new program, a withdrawn
+    // one) in O(log n) instead of a rebuild. Each edit derives a new SeatMatrixSnapshot, which
+    // copies only the nodes on the edit's path, and publishes it with one atomic pointer store,
+    // so readers never lock: each query works on the snapshot it loaded while writers build the next.
+    class DynamicIntervalIndex : public AllocationStrategy {
+    private:
+        // Current snapshot; read with std::atomic_load, replaced with std::atomic_store
+        std::shared_ptr<const SeatMatrixSnapshot> current;
+
+        // Serializes writers; readers never take it
+        std::mutex editMutex;
+
+        // Number of edits applied since the table was built
+        std::atomic<std::uint64_t> editCount{ 0 };
+
+    public:
+        // Empty table with a private name pool
+        DynamicIntervalIndex() : current(std::make_shared<const SeatMatrixSnapshot>()) {}
+
+        // Copies a loaded seat matrix, keeping its IDs and sharing its name pool
+        explicit DynamicIntervalIndex(const RankIntervalStrategy& table) : current(std::make_shared<const SeatMatrixSnapshot>(table)) {}
+
+        // Continues editing from an existing snapshot
+        explicit DynamicIntervalIndex(SeatMatrixSnapshot start) : current(std::make_shared<const SeatMatrixSnapshot>(std::move(start))) {}
+
+        DynamicIntervalIndex(const DynamicIntervalIndex&) = delete;
+        DynamicIntervalIndex& operator=(const DynamicIntervalIndex&) = delete;
+
+        std::string allocateCollege(int userRank) const override {
+            return std::atomic_load(&current)->allocateCollege(userRank);
+        }
+
+        int allocateCollegeId(int userRank) const override {
+            return std::atomic_load(&current)->allocateCollegeId(userRank);
+        }
+
+        // Answers the whole batch from one snapshot, so a concurrent edit never splits it
+        void allocateCollegeIds(const std::int32_t* userRanks, std::int32_t* collegeIds, size_t count) const override {
+            std::atomic_load(&current)->allocateCollegeIds(userRanks, collegeIds, count);
+        }
+
+        // The current state, unaffected by later edits
+        SeatMatrixSnapshot snapshot() const {
+            return *std::atomic_load(&current);
+        }
+
+        // Adds a college interval under the next ID and returns that ID
+        int addInterval(int rankStart, int rankEnd, const std::string& college) {
+            std::lock_guard<std::mutex> lock(editMutex);
+            int collegeId = current->getCollegeCount();
+            publish(current->withInterval(rankStart, rankEnd, college));
+            return collegeId;
+        }
+
+        // Withdraws a college's interval; its ID and name stay with an empty range
+        void removeInterval(int collegeId) {
+            std::lock_guard<std::mutex> lock(editMutex);
+            publish(current->withoutInterval(collegeId));
+        }
+
+        // Moves a college's interval to [rankStart, rankEnd]
+        void resizeInterval(int collegeId, int rankStart, int rankEnd) {
+            std::lock_guard<std::mutex> lock(editMutex);
+            publish(current->withRankInterval(collegeId, rankStart, rankEnd));
+        }
+
+        // Number of IDs ever assigned, removed ones included
+        int getCollegeCount() const {
+            return std::atomic_load(&current)->getCollegeCount();
+        }
+
+        // Number of live (non-empty) intervals
+        size_t getIntervalCount() const {
+            return std::atomic_load(&current)->getIntervalCount();
+        }
+
+        std::uint64_t getEditCount() const {
+            return editCount.load();
+        }
+
+        const std::string& getCollegeName(int collegeId) const {
+            return std::atomic_load(&current)->getCollegeName(collegeId);
+        }
+
+        // Rank interval [start, end] of a college; start > end once removed
+        std::pair<int, int> getRankInterval(int collegeId) const {
+            return std::atomic_load(&current)->getRankInterval(collegeId);
+        }
+
+    private:
+        void publish(SeatMatrixSnapshot next) {
+            std::atomic_store(&current, std::make_shared<const SeatMatrixSnapshot>(std::move(next)));
+            ++editCount;
+        }
+    };
+
+    // Applies a corrections file to the index, one edit per line:
+    //   + start-end: name   adds an interval under the next ID
+    //   - id                withdraws a college's interval
+    //   = id start-end      moves a college's interval
+    // Blank lines and "//" comment lines are skipped. Returns the number of edits applied.
+    inline size_t applySeatCorrections(DynamicIntervalIndex& index, std::istream& corrections) {
+        size_t applied = 0;
+        std::string line;
+        for (size_t lineNumber = 1; std::getline(corrections, line); ++lineNumber) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            size_t first = line.find_first_not_of(" \t");
+            if (first == std::string::npos || line.compare(first, 2, "//") == 0) {
+                continue;
+            }
+            std::istringstream fields(line.substr(first + 1));
+            int collegeId = AllocationStrategy::noCollegeId;
+            int rankStart = 0;
+            int rankEnd = 0;
+            char hyphen = 0;
+            char colon = 0;
+            bool parsed = false;
+            if (line[first] == '+') {
+                parsed = static_cast<bool>(fields >> rankStart >> hyphen >> rankEnd >> colon) && hyphen == '-' && colon == ':';
+                if (parsed) {
+                    std::string name;
+                    std::getline(fields >> std::ws, name);
+                    while (!name.empty() && (name.back() == ' ' || name.back() == '\t')) {
+                        name.pop_back();
+                    }
+                    parsed = !name.empty();
+                    if (parsed) {
+                        index.addInterval(rankStart, rankEnd, name);
+                    }
+                }
+            } else if (line[first] == '-') {
+                parsed = static_cast<bool>(fields >> collegeId);
+                if (parsed) {
+                    index.removeInterval(collegeId);
+                }
+            } else if (line[first] == '=') {
+                parsed = static_cast<bool>(fields >> collegeId >> rankStart >> hyphen >> rankEnd) && hyphen == '-';
+                if (parsed) {
+                    index.resizeInterval(collegeId, rankStart, rankEnd);
+                }
+            }
+            if (!parsed) {
+                throw std::runtime_error("Error: Invalid correction on line " + std::to_string(lineNumber) + ": " + line);
+            }
+            ++applied;
+        }
+        return applied;
+    }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Bits.h"
+
+namespace CollegeCounseling {
+    // Unsigned integers of one fixed bit width packed back to back in 64-bit words
+    class PackedIntArray {
+    private:
+        std::vector<std::uint64_t> words;
+        int width = 0;
+        size_t count = 0;
+
+    public:
+        PackedIntArray() = default;
+
+        PackedIntArray(size_t size, int bitWidth)
+            : words((size * static_cast<size_t>(bitWidth) + 63) / 64, 0), width(bitWidth), count(size) {}
+
+        // Bits needed to store every value up to maxValue
+        static int bitsFor(std::uint64_t maxValue) {
+            int bits = 0;
+            while (bits < 64 && (maxValue >> bits) != 0) {
+                ++bits;
+            }
+            return bits;
+        }
+
+        // Stores a value into a slot that is still zero
+        void set(size_t i, std::uint64_t value) {
+            if (width == 0) {
+                return;
+            }
+            size_t bit = i * static_cast<size_t>(width);
+            int offset = static_cast<int>(bit % 64);
+            words[bit / 64] |= value << offset;
+            if (offset + width > 64) {
+                words[bit / 64 + 1] |= value >> (64 - offset);
+            }
+        }
+
+        std::uint64_t get(size_t i) const {
+            if (width == 0) {
+                return 0;
+            }
+            size_t bit = i * static_cast<size_t>(width);
+            int offset = static_cast<int>(bit % 64);
+            std::uint64_t value = words[bit / 64] >> offset;
+            if (offset + width > 64) {
+                value |= words[bit / 64 + 1] << (64 - offset);
+            }
+            return width == 64 ? value : value & ((std::uint64_t(1) << width) - 1);
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        size_t getMemoryBytes() const {
+            return words.capacity() * sizeof(std::uint64_t);
+        }
+    };
+
+    // Elias-Fano encoding of a non-decreasing sequence of n values below u, in about
+    // 2 + log2(u / n) bits per value. Each value is split into lowBits low bits, stored packed,
+    // and a high part stored in unary: value i sets bit (high_i + i) of the upper bit vector, so
+    // the values of high part h sit right after the h-th zero. Select samples on every
+    // sampleRate-th one and zero make access and predecessor counts O(1) on average.
+    class EliasFanoSequence {
+    private:
+        static constexpr size_t sampleRate = 64;
+
+        size_t count = 0;
+        int lowBits = 0;
+        std::uint64_t maxHigh = 0;
+        PackedIntArray lower;
+        std::vector<std::uint64_t> upper;
+        size_t upperBits = 0;
+        // Bit positions of every sampleRate-th one and zero of upper
+        std::vector<std::uint64_t> oneSamples;
+        std::vector<std::uint64_t> zeroSamples;
+
+    public:
+        // Encodes values, which must be non-decreasing
+        void build(const std::vector<std::uint64_t>& values) {
+            count = values.size();
+            std::uint64_t universe = values.empty() ? 1 : values.back() + 1;
+            lowBits = 0;
+            while (count > 0 && (universe >> (lowBits + 1)) >= count) {
+                ++lowBits;
+            }
+            maxHigh = (universe - 1) >> lowBits;
+            upperBits = count + static_cast<size_t>(maxHigh) + 1;
+            upper.assign((upperBits + 63) / 64, 0);
+            lower = PackedIntArray(count, lowBits);
+            std::uint64_t lowMask = lowBits == 0 ? 0 : (~std::uint64_t(0) >> (64 - lowBits));
+            for (size_t i = 0; i < count; ++i) {
+                if (i > 0 && values[i] < values[i - 1]) {
+                    throw std::runtime_error("Error: Elias-Fano values must be non-decreasing.");
+                }
+                size_t bit = static_cast<size_t>(values[i] >> lowBits) + i;
+                upper[bit / 64] |= std::uint64_t(1) << (bit % 64);
+                lower.set(i, values[i] & lowMask);
+            }
+
+            oneSamples.clear();
+            zeroSamples.clear();
+            size_t ones = 0;
+            size_t zeros = 0;
+            for (size_t bit = 0; bit < upperBits; ++bit) {
+                if ((upper[bit / 64] >> (bit % 64)) & 1) {
+                    if (ones++ % sampleRate == 0) {
+                        oneSamples.push_back(bit);
+                    }
+                } else if (zeros++ % sampleRate == 0) {
+                    zeroSamples.push_back(bit);
+                }
+            }
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        // Value i
+        std::uint64_t operator[](size_t i) const {
+            std::uint64_t high = static_cast<std::uint64_t>(selectOne(i) - i);
+            return (high << lowBits) | lower.get(i);
+        }
+
+        // Number of values <= x, so the last of them is value countAtMost(x) - 1
+        size_t countAtMost(std::uint64_t x) const {
+            std::uint64_t high = x >> lowBits;
+            if (high > maxHigh) {
+                return count;
+            }
+            // Values of high part `high` start right after its high-th zero
+            size_t position = high == 0 ? 0 : selectZero(static_cast<size_t>(high - 1)) + 1;
+            size_t index = position - static_cast<size_t>(high);
+            std::uint64_t low = lowBits == 0 ? 0 : x & (~std::uint64_t(0) >> (64 - lowBits));
+            while (position < upperBits && ((upper[position / 64] >> (position % 64)) & 1) && lower.get(index) <= low) {
+                ++position;
+                ++index;
+            }
+            return index;
+        }
+
+        size_t getMemoryBytes() const {
+            return lower.getMemoryBytes() + upper.capacity() * sizeof(std::uint64_t)
+                 + (oneSamples.capacity() + zeroSamples.capacity()) * sizeof(std::uint64_t);
+        }
+
+    private:
+        // Bit position of the k-th one (0-based) of upper
+        size_t selectOne(size_t k) const {
+            return select(k, oneSamples, false);
+        }
+
+        // Bit position of the k-th zero (0-based) of upper
+        size_t selectZero(size_t k) const {
+            return select(k, zeroSamples, true);
+        }
+
+        // Jumps to the nearest sample, then counts whole words until the word holding the target bit
+        size_t select(size_t k, const std::vector<std::uint64_t>& samples, bool zeros) const {
+            size_t position = static_cast<size_t>(samples[k / sampleRate]);
+            size_t remaining = k % sampleRate;
+            size_t word = position / 64;
+            std::uint64_t bits = (zeros ? ~upper[word] : upper[word]) & (~std::uint64_t(0) << (position % 64));
+            for (;;) {
+                size_t found = static_cast<size_t>(countSetBits(bits));
+                if (remaining < found) {
+                    return word * 64 + static_cast<size_t>(selectSetBit(bits, static_cast<int>(remaining)));
+                }
+                remaining -= found;
+                ++word;
+                bits = zeros ? ~upper[word] : upper[word];
+            }
+        }
+    };
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "AllocationStrategy.h"
+#include "RankIntervalStrategy.h"
+
+#ifdef COUNSELING_EMBEDDED_MATRIX
+#include COUNSELING_EMBEDDED_MATRIX
+#endif
+
+namespace CollegeCounseling {
+    // Branch-free binary search over a fixed-size boundary array. The trip count depends only
+    // on N, so the loop unrolls completely and every step is a conditional move; being
+    // constexpr, lookups on compile-time ranks fold to constants.
+    template <std::size_t N>
+    constexpr std::int32_t constexprSegmentLookup(const int (&starts)[N], const std::int32_t (&ids)[N], int rank) {
+        std::size_t base = 0;
+        for (std::size_t remaining = N; remaining > 1;) {
+            std::size_t half = remaining / 2;
+            base = starts[base + half] <= rank ? base + half : base;
+            remaining -= half;
+        }
+        return starts[base] <= rank ? ids[base] : AllocationStrategy::noCollegeId;
+    }
+
+    // Writes a seat matrix as a header of constexpr arrays for builds that embed it
+    // (compile with -DCOUNSELING_EMBEDDED_MATRIX='"header.h"')
+    class EmbeddedMatrixGenerator {
+    public:
+        static void write(const RankIntervalStrategy& index, const std::string& sourceFile, std::ostream& out) {
+            const HugeVector<int>& starts = index.getSegmentStarts();
+            const HugeVector<std::int32_t>& ids = index.getSegmentIds();
+
+            out << "// Generated by project --embed from " << sourceFile << "; do not edit.\n"
+                << "#pragma once\n\n"
+                << "namespace CollegeCounseling {\n"
+                << "    namespace EmbeddedSeatMatrix {\n"
+                << "        constexpr std::uint32_t snapshotVersion = " << index.getSnapshotVersion() << "u;\n\n";
+
+            // An empty table still needs one gap segment so the arrays are never zero-sized
+            out << "        constexpr int segmentStarts[] = {";
+            if (starts.empty()) {
+                out << " 0";
+            }
+            for (size_t i = 0; i < starts.size(); ++i) {
+                out << (i % 12 == 0 ? "\n            " : " ") << starts[i] << ",";
+            }
+            out << "\n        };\n\n        constexpr std::int32_t segmentIds[] = {";
+            if (ids.empty()) {
+                out << " -1";
+            }
+            for (size_t i = 0; i < ids.size(); ++i) {
+                out << (i % 16 == 0 ? "\n            " : " ") << ids[i] << ",";
+            }
+            out << "\n        };\n\n        constexpr const char* collegeNames[] = {";
+            if (index.getCollegeCount() == 0) {
+                out << " \"\"";
+            }
+            for (int id = 0; id < index.getCollegeCount(); ++id) {
+                out << "\n            " << quote(index.getCollegeName(id)) << ",";
+            }
+            out << "\n        };\n\n        constexpr int collegeCount = " << index.getCollegeCount() << ";\n"
+                << "    }\n"
+                << "}\n";
+            if (!out) {
+                throw std::runtime_error("Error: Cannot write embedded header.");
+            }
+        }
+
+    private:
+        // C++ string literal with quotes, backslashes and control bytes escaped
+        static std::string quote(const std::string& text) {
+            static const char digits[] = "0123456789abcdef";
+            std::string literal = "\"";
+            for (unsigned char c : text) {
+                if (c == '"' || c == '\\') {
+                    literal += '\\';
+                    literal += static_cast<char>(c);
+                } else if (c < 0x20 || c >= 0x7f) {
+                    literal += "\\x";
+                    literal += digits[c >> 4];
+                    literal += digits[c & 0xf];
+                    literal += "\"\"";
+                } else {
+                    literal += static_cast<char>(c);
+                }
+            }
+            return literal + "\"";
+        }
+    };
+
+#ifdef COUNSELING_EMBEDDED_MATRIX
+    // Strategy answering from the compiled-in seat matrix: no file I/O or parsing at startup
+    class EmbeddedIntervalStrategy : public AllocationStrategy {
+    private:
+        static_assert(sizeof(EmbeddedSeatMatrix::segmentStarts) / sizeof(int) == sizeof(EmbeddedSeatMatrix::segmentIds) / sizeof(std::int32_t),
+                      "Embedded seat matrix arrays must have one ID per segment");
+        static_assert(constexprSegmentLookup(EmbeddedSeatMatrix::segmentStarts, EmbeddedSeatMatrix::segmentIds,
+                                             EmbeddedSeatMatrix::segmentStarts[0]) == EmbeddedSeatMatrix::segmentIds[0],
+                      "Embedded seat matrix lookup must resolve at compile time");
+
+    public:
+        std::string allocateCollege(int userRank) const override {
+            int collegeId = allocateCollegeId(userRank);
+            if (collegeId == noCollegeId) {
+                return "No college allocated for your rank.";
+            }
+            return EmbeddedSeatMatrix::collegeNames[collegeId];
+        }
+
+        int allocateCollegeId(int userRank) const override {
+            return constexprSegmentLookup(EmbeddedSeatMatrix::segmentStarts, EmbeddedSeatMatrix::segmentIds, userRank);
+        }
+
+        std::uint32_t getSnapshotVersion() const {
+            return EmbeddedSeatMatrix::snapshotVersion;
+        }
+    };
+#endif
+}
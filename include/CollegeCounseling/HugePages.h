@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace CollegeCounseling {
+    // Page backing for large read-only arrays
+    enum class HugePagePolicy {
+        Disabled,
+        Transparent,
+        Explicit
+    };
+
+    // Process-wide huge page setting. Defaults to the COUNSELING_HUGE_PAGES environment
+    // variable ("transparent" or "explicit"), otherwise disabled.
+    class HugePages {
+    public:
+        // Allocations smaller than one 2MB page never use huge pages
+        static constexpr size_t pageSize = size_t(2) << 20;
+
+        static HugePagePolicy getPolicy() {
+            return policy();
+        }
+
+        static void setPolicy(HugePagePolicy newPolicy) {
+            policy() = newPolicy;
+        }
+
+        // Maps a 2MB-rounded, 2MB-aligned region: MAP_HUGETLB for Explicit (falling back to
+        // Transparent when no huge pages are reserved), madvise(MADV_HUGEPAGE) for Transparent,
+        // plain pages otherwise. mmap only promises 4KB alignment, and THP can back only whole
+        // aligned 2MB ranges, so the fallback maps one page extra and trims the unaligned ends.
+        static void* map(size_t bytes) {
+#if defined(__linux__)
+            size_t length = roundUp(bytes);
+            void* region = MAP_FAILED;
+            HugePagePolicy current = getPolicy();
+            if (current == HugePagePolicy::Explicit) {
+                region = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+            if (region == MAP_FAILED) {
+                void* padded = ::mmap(nullptr, length + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (padded == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                char* start = static_cast<char*>(padded);
+                char* aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::uintptr_t>(start)));
+                size_t head = static_cast<size_t>(aligned - start);
+                if (head != 0) {
+                    ::munmap(start, head);
+                }
+                if (pageSize - head != 0) {
+                    ::munmap(aligned + length, pageSize - head);
+                }
+                region = aligned;
+                if (current != HugePagePolicy::Disabled) {
+                    ::madvise(region, length, MADV_HUGEPAGE);
+                }
+            }
+            return region;
+#else
+            return ::operator new(bytes);
+#endif
+        }
+
+        static void unmap(void* region, size_t bytes) {
+#if defined(__linux__)
+            ::munmap(region, roundUp(bytes));
+#else
+            ::operator delete(region);
+#endif
+        }
+
+    private:
+        static HugePagePolicy& policy() {
+            static HugePagePolicy current = fromEnvironment();
+            return current;
+        }
+
+        static HugePagePolicy fromEnvironment() {
+            const char* setting = std::getenv("COUNSELING_HUGE_PAGES");
+            std::string value = setting ? setting : "";
+            if (value == "explicit") {
+                return HugePagePolicy::Explicit;
+            }
+            if (value == "transparent") {
+                return HugePagePolicy::Transparent;
+            }
+            return HugePagePolicy::Disabled;
+        }
+
+        static std::uintptr_t roundUp(std::uintptr_t bytes) {
+            return (bytes + pageSize - 1) / pageSize * pageSize;
+        }
+    };
+
+    // Allocator placing arrays of at least one huge page in their own 2MB-aligned mapping;
+    // smaller arrays use the regular heap. The choice depends only on the size, so deallocate
+    // always matches allocate even if the policy changes in between.
+    template <typename T>
+    class HugePageAllocator {
+    public:
+        using value_type = T;
+
+        HugePageAllocator() = default;
+
+        template <typename U>
+        HugePageAllocator(const HugePageAllocator<U>&) {}
+
+        T* allocate(size_t count) {
+            size_t bytes = count * sizeof(T);
+            if (bytes >= HugePages::pageSize) {
+                return static_cast<T*>(HugePages::map(bytes));
+            }
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void deallocate(T* pointer, size_t count) {
+            size_t bytes = count * sizeof(T);
+            if (bytes >= HugePages::pageSize) {
+                HugePages::unmap(pointer, bytes);
+                return;
+            }
+            ::operator delete(pointer);
+        }
+
+        template <typename U>
+        bool operator==(const HugePageAllocator<U>&) const {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const HugePageAllocator<U>&) const {
+            return false;
+        }
+    };
+
+    // Vector for large, mostly read-only arrays
+    template <typename T>
+    using HugeVector = std::vector<T, HugePageAllocator<T>>;
+}
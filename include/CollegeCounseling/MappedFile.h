@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+namespace CollegeCounseling {
+    // Read-only contents of a whole file, opened once. POSIX systems map the file; elsewhere,
+    // and for empty files, the bytes are read into an owned buffer. Move-only, so a loader
+    // taking one by value owns the mapping and decides how long to keep it.
+    class MappedFile {
+    private:
+        std::string path;
+        const char* bytes = nullptr;
+        size_t length = 0;
+        bool mapped = false;
+        std::string owned;
+
+    public:
+        // How the mapping will be read, passed to the kernel as a readahead hint
+        enum class Access {
+            // Front to back once, as the loaders parse
+            Sequential,
+            // Scattered reads kept open, e.g. sections parsed on first use
+            Random
+        };
+
+        MappedFile() = default;
+
+        // Opens and maps a file; throws when it cannot be opened or read
+        static MappedFile open(const std::string& filePath, Access access = Access::Sequential) {
+            MappedFile file;
+            file.path = filePath;
+#ifdef _WIN32
+            int fd = ::_open(filePath.c_str(), _O_RDONLY | _O_BINARY);
+            if (fd < 0) {
+                throw std::runtime_error("Error: Cannot open " + filePath);
+            }
+            struct _stat64 info;
+            bool readable = ::_fstat64(fd, &info) == 0;
+            if (readable) {
+                file.owned.resize(static_cast<size_t>(info.st_size));
+                size_t done = 0;
+                while (readable && done < file.owned.size()) {
+                    int chunk = ::_read(fd, &file.owned[done], static_cast<unsigned>(std::min<size_t>(file.owned.size() - done, 1u << 30)));
+                    readable = chunk > 0;
+                    done += readable ? static_cast<size_t>(chunk) : 0;
+                }
+            }
+            ::_close(fd);
+            if (!readable) {
+                throw std::runtime_error("Error: Cannot read " + filePath);
+            }
+            file.bytes = file.owned.data();
+            file.length = file.owned.size();
+#else
+            int fd = ::open(filePath.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Error: Cannot open " + filePath);
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Error: Cannot read " + filePath);
+            }
+            file.length = static_cast<size_t>(info.st_size);
+            if (file.length > 0) {
+                void* region = ::mmap(nullptr, file.length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (region == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Error: Cannot map " + filePath);
+                }
+                file.bytes = static_cast<const char*>(region);
+                file.mapped = true;
+                file.advise(access);
+            }
+            ::close(fd);
+#endif
+            return file;
+        }
+
+        // Wraps bytes already in memory, e.g. for data that did not come from a file
+        static MappedFile fromString(std::string contents, const std::string& name = "<memory>") {
+            MappedFile file;
+            file.path = name;
+            file.owned = std::move(contents);
+            file.bytes = file.owned.data();
+            file.length = file.owned.size();
+            return file;
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                path = std::move(other.path);
+                owned = std::move(other.owned);
+                mapped = other.mapped;
+                length = other.length;
+                bytes = mapped ? other.bytes : owned.data();
+                other.bytes = nullptr;
+                other.length = 0;
+                other.mapped = false;
+            }
+            return *this;
+        }
+
+        ~MappedFile() {
+            release();
+        }
+
+        const char* data() const {
+            return bytes;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        char operator[](size_t position) const {
+            return bytes[position];
+        }
+
+        std::string_view view() const {
+            return std::string_view(bytes, length);
+        }
+
+        const std::string& getPath() const {
+            return path;
+        }
+
+        // Changes the readahead hint, for callers that learn the access pattern from the
+        // contents; a no-op for owned buffers
+        void advise([[maybe_unused]] Access access) const {
+#ifndef _WIN32
+            if (mapped) {
+                ::madvise(const_cast<char*>(bytes), length, access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+            }
+#endif
+        }
+
+    private:
+        void release() {
+#ifndef _WIN32
+            if (mapped) {
+                ::munmap(const_cast<char*>(bytes), length);
+            }
+#endif
+            bytes = nullptr;
+            length = 0;
+            mapped = false;
+        }
+    };
+}
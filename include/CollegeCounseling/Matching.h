@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "CollegeApplication.h"
+#include "Parallel.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Ranked college choices for every applicant, stored back to back (CSR layout)
+    struct PreferenceTable {
+        std::vector<std::uint32_t> offsets{ 0 };
+        std::vector<std::int32_t> colleges;
+
+        // Number of applicants with a list
+        size_t size() const {
+            return offsets.size() - 1;
+        }
+
+        // Appends one applicant's list
+        void add(const std::int32_t* choices, size_t count) {
+            colleges.insert(colleges.end(), choices, choices + count);
+            offsets.push_back(static_cast<std::uint32_t>(colleges.size()));
+        }
+
+        // Appends one applicant's list given by college names
+        void addByName(const RankIntervalStrategy& index, const std::vector<std::string>& names) {
+            for (const std::string& name : names) {
+                int collegeId = index.findCollegeId(name);
+                if (collegeId == AllocationStrategy::noCollegeId) {
+                    throw std::runtime_error("Error: Unknown college in preference list: " + name);
+                }
+                colleges.push_back(collegeId);
+            }
+            offsets.push_back(static_cast<std::uint32_t>(colleges.size()));
+        }
+
+        // Default model: the table lists colleges best first, so applicants rank the colleges
+        // within window entries of the one their rank maps to, in table order
+        static PreferenceTable fromRankIntervals(const RankIntervalStrategy& index,
+                                                 const std::vector<CollegeApplication>& applications, int window) {
+            PreferenceTable table;
+            table.offsets.reserve(applications.size() + 1);
+            int lastCollege = index.getCollegeCount() - 1;
+            std::vector<std::int32_t> choices;
+            for (const CollegeApplication& application : applications) {
+                int own = index.allocateCollegeId(application.getApplicantRank());
+                if (own == AllocationStrategy::noCollegeId) {
+                    own = lastCollege;
+                }
+                choices.clear();
+                for (int id = std::max(0, own - window); id <= std::min(lastCollege, own + window); ++id) {
+                    choices.push_back(id);
+                }
+                table.add(choices.data(), choices.size());
+            }
+            return table;
+        }
+
+        // Model of a batch round: each applicant lists only the college the round's strategy
+        // maps their rank to, or nothing when it maps to none
+        static PreferenceTable fromRoundStrategy(const AllocationStrategy& strategy, const std::vector<CollegeApplication>& applications) {
+            std::vector<std::int32_t> ranks(applications.size());
+            for (size_t i = 0; i < applications.size(); ++i) {
+                ranks[i] = applications[i].getApplicantRank();
+            }
+            std::vector<std::int32_t> collegeIds(applications.size());
+            strategy.allocateCollegeIds(ranks.data(), collegeIds.data(), ranks.size());
+
+            PreferenceTable table;
+            table.offsets.reserve(applications.size() + 1);
+            table.colleges.reserve(applications.size());
+            for (std::int32_t collegeId : collegeIds) {
+                table.add(&collegeId, collegeId == AllocationStrategy::noCollegeId ? 0 : 1);
+            }
+            return table;
+        }
+    };
+
+    // Rank-order serial dictatorship: in the given order each applicant takes the first listed
+    // college with a free seat, which is the stable matching when colleges share one merit list
+    class SerialDictatorship {
+    public:
+        static std::vector<std::int32_t> allocate(const std::vector<std::uint32_t>& order, const PreferenceTable& preferences,
+                                                  std::vector<int> seatsLeft) {
+            std::vector<std::int32_t> result(preferences.size(), AllocationStrategy::noCollegeId);
+            for (std::uint32_t applicant : order) {
+                for (std::uint32_t k = preferences.offsets[applicant]; k < preferences.offsets[applicant + 1]; ++k) {
+                    std::int32_t collegeId = preferences.colleges[k];
+                    if (seatsLeft[collegeId] > 0) {
+                        --seatsLeft[collegeId];
+                        result[applicant] = collegeId;
+                        break;
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+    // An applicant and a college that would both rather be matched to each other
+    struct BlockingPair {
+        size_t applicantIndex;
+        std::int32_t collegeId;
+    };
+
+    // Findings of a stability check; an allocation is certified when all lists are empty
+    struct StabilityReport {
+        std::vector<BlockingPair> blockingPairs;
+        std::vector<std::int32_t> overfilledColleges;
+        std::vector<size_t> unlistedAssignments;
+
+        bool isStable() const {
+            return blockingPairs.empty() && overfilledColleges.empty() && unlistedAssignments.empty();
+        }
+    };
+
+    // Certifies an allocation against preferences, capacities and the merit order. A full
+    // college's cutoff is the merit position of the weakest applicant it admitted, so each
+    // applicant only needs checking against the colleges it listed above its own seat:
+    // one of those blocks if it has a free seat or a cutoff below the applicant's merit.
+    class StabilityVerifier {
+    public:
+        static StabilityReport verify(const std::vector<std::uint32_t>& meritOrder, const PreferenceTable& preferences,
+                                      const std::vector<int>& capacities, const std::vector<std::int32_t>& result,
+                                      unsigned workerCount = 0) {
+            if (meritOrder.size() != result.size() || preferences.size() != result.size()) {
+                throw std::runtime_error("Error: Allocation, preferences and merit order cover different applicants.");
+            }
+            if (workerCount == 0) {
+                workerCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            std::vector<std::uint32_t> meritPosition(result.size());
+            for (size_t position = 0; position < meritOrder.size(); ++position) {
+                meritPosition[meritOrder[position]] = static_cast<std::uint32_t>(position);
+            }
+
+            // Cutoffs: colleges with a free seat accept anyone
+            StabilityReport report;
+            const std::uint32_t openCutoff = std::numeric_limits<std::uint32_t>::max();
+            std::vector<int> admitted(capacities.size(), 0);
+            std::vector<std::uint32_t> cutoff(capacities.size(), 0);
+            for (size_t applicant = 0; applicant < result.size(); ++applicant) {
+                std::int32_t collegeId = result[applicant];
+                if (collegeId == AllocationStrategy::noCollegeId) {
+                    continue;
+                }
+                if (collegeId < 0 || static_cast<size_t>(collegeId) >= capacities.size()) {
+                    throw std::runtime_error("Error: Allocation refers to an unknown college.");
+                }
+                ++admitted[collegeId];
+                cutoff[collegeId] = std::max(cutoff[collegeId], meritPosition[applicant]);
+            }
+            for (size_t c = 0; c < capacities.size(); ++c) {
+                if (admitted[c] > capacities[c]) {
+                    report.overfilledColleges.push_back(static_cast<std::int32_t>(c));
+                }
+                if (admitted[c] < capacities[c]) {
+                    cutoff[c] = openCutoff;
+                }
+            }
+
+            std::vector<StabilityReport> partials(workerCount);
+            runInParallel(result.size(), workerCount, [&](size_t begin, size_t end, unsigned worker) {
+                StabilityReport& partial = partials[worker];
+                for (size_t applicant = begin; applicant < end; ++applicant) {
+                    std::uint32_t merit = meritPosition[applicant];
+                    std::uint32_t k = preferences.offsets[applicant];
+                    std::uint32_t listEnd = preferences.offsets[applicant + 1];
+                    for (; k < listEnd && preferences.colleges[k] != result[applicant]; ++k) {
+                        std::int32_t preferred = preferences.colleges[k];
+                        if (cutoff[preferred] == openCutoff || merit < cutoff[preferred]) {
+                            partial.blockingPairs.push_back({ applicant, preferred });
+                        }
+                    }
+                    if (k == listEnd && result[applicant] != AllocationStrategy::noCollegeId) {
+                        partial.unlistedAssignments.push_back(applicant);
+                    }
+                }
+            });
+            for (const StabilityReport& partial : partials) {
+                report.blockingPairs.insert(report.blockingPairs.end(), partial.blockingPairs.begin(), partial.blockingPairs.end());
+                report.unlistedAssignments.insert(report.unlistedAssignments.end(), partial.unlistedAssignments.begin(),
+                                                  partial.unlistedAssignments.end());
+            }
+            return report;
+        }
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace CollegeCounseling {
+    // Splits [0, count) into one contiguous chunk per worker and runs them on separate threads;
+    // workerCount 0 picks the hardware concurrency. The first exception from any worker is rethrown.
+    inline void runInParallel(size_t count, unsigned workerCount,
+                              const std::function<void(size_t begin, size_t end, unsigned worker)>& body) {
+        if (workerCount == 0) {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workerCount = static_cast<unsigned>(std::min<size_t>(workerCount, std::max<size_t>(count, 1)));
+        if (workerCount == 1) {
+            body(0, count, 0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        std::vector<std::exception_ptr> errors(workerCount);
+        size_t chunk = (count + workerCount - 1) / workerCount;
+        for (unsigned worker = 0; worker < workerCount; ++worker) {
+            size_t begin = std::min(count, worker * chunk);
+            size_t end = std::min(count, begin + chunk);
+            workers.emplace_back([&body, &errors, begin, end, worker] {
+                try {
+                    body(begin, end, worker);
+                } catch (...) {
+                    errors[worker] = std::current_exception();
+                }
+            });
+        }
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "CollegeApplication.h"
+#include "Parallel.h"
+
+namespace CollegeCounseling {
+    // Philox4x32-10 counter-based generator. Every (key, stream) pair is an independent
+    // sequence and any position in it can be computed directly, so results never depend on
+    // which thread draws them.
+    class PhiloxRng {
+    private:
+        std::uint32_t key[2];
+        std::uint32_t counter[4];
+        std::uint32_t output[4];
+        int available = 0;
+
+    public:
+        PhiloxRng(std::uint64_t seed, std::uint64_t stream)
+            : key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) },
+              counter{ 0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) },
+              output{ 0, 0, 0, 0 } {}
+
+        // Next 32 random bits
+        std::uint32_t next() {
+            if (available == 0) {
+                block(key, counter, output);
+                if (++counter[0] == 0) {
+                    ++counter[1];
+                }
+                available = 4;
+            }
+            return output[4 - available--];
+        }
+
+        // Uniform double in [0, 1) built from 53 random bits
+        double nextUnit() {
+            std::uint64_t high = next() >> 5, low = next() >> 6;
+            return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+        }
+
+        // Ten Philox rounds over one 128-bit counter
+        static void block(const std::uint32_t inputKey[2], const std::uint32_t inputCounter[4], std::uint32_t result[4]) {
+            std::uint32_t k0 = inputKey[0], k1 = inputKey[1];
+            std::uint32_t c0 = inputCounter[0], c1 = inputCounter[1], c2 = inputCounter[2], c3 = inputCounter[3];
+            for (int round = 0; round < 10; ++round) {
+                std::uint64_t product0 = std::uint64_t(0xD2511F53u) * c0;
+                std::uint64_t product1 = std::uint64_t(0xCD9E8D57u) * c2;
+                std::uint32_t n0 = static_cast<std::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+                std::uint32_t n2 = static_cast<std::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+                c1 = static_cast<std::uint32_t>(product1);
+                c3 = static_cast<std::uint32_t>(product0);
+                c0 = n0;
+                c2 = n2;
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            result[0] = c0;
+            result[1] = c1;
+            result[2] = c2;
+            result[3] = c3;
+        }
+    };
+
+    // Breaks rank ties by lottery. An applicant's lottery number is a Philox block keyed by the
+    // seed with the applicant ID as the counter, so it depends on nothing but (seed, ID) and
+    // any thread count or schedule produces the same merit order. Applicant IDs must be
+    // distinct (ApplicantLoader numbers rows), or tied applicants draw the same number.
+    class LotteryTieBreaker {
+    private:
+        std::uint32_t key[2];
+
+        // Sort key giving a strict total order over applications
+        struct MeritKey {
+            int rank;
+            std::uint64_t lottery;
+            int applicantId;
+            std::uint32_t index;
+
+            bool operator<(const MeritKey& other) const {
+                if (rank != other.rank) return rank < other.rank;
+                if (lottery != other.lottery) return lottery < other.lottery;
+                if (applicantId != other.applicantId) return applicantId < other.applicantId;
+                return index < other.index;
+            }
+        };
+
+    public:
+        explicit LotteryTieBreaker(std::uint64_t seed)
+            : key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) } {}
+
+        // 64-bit lottery number of an applicant
+        std::uint64_t lotteryNumber(int applicantId) const {
+            std::uint64_t id = static_cast<std::uint32_t>(applicantId);
+            std::uint32_t counter[4] = { static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(id >> 32), 0x54494521u, 0 };
+            std::uint32_t block[4];
+            PhiloxRng::block(key, counter, block);
+            return (std::uint64_t(block[0]) << 32) | block[1];
+        }
+
+        // Application indices best first: by rank, then lottery number. Keys are drawn and
+        // chunks sorted in parallel, then merged; the order is total so the result is the same
+        // for every worker count.
+        std::vector<std::uint32_t> meritOrder(const std::vector<CollegeApplication>& applications, unsigned workerCount = 0) const {
+            std::vector<MeritKey> keys(applications.size());
+            std::vector<size_t> chunkEnds;
+            std::mutex chunkMutex;
+            runInParallel(keys.size(), workerCount, [&](size_t begin, size_t end, unsigned) {
+                for (size_t i = begin; i < end; ++i) {
+                    const CollegeApplication& application = applications[i];
+                    keys[i] = { application.getApplicantRank(), lotteryNumber(application.getApplicantId()),
+                                application.getApplicantId(), static_cast<std::uint32_t>(i) };
+                }
+                std::sort(keys.begin() + static_cast<std::ptrdiff_t>(begin), keys.begin() + static_cast<std::ptrdiff_t>(end));
+                std::lock_guard<std::mutex> lock(chunkMutex);
+                chunkEnds.push_back(end);
+            });
+
+            std::sort(chunkEnds.begin(), chunkEnds.end());
+            size_t merged = chunkEnds.empty() ? 0 : chunkEnds.front();
+            for (size_t k = 1; k < chunkEnds.size(); ++k) {
+                std::inplace_merge(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(merged),
+                                   keys.begin() + static_cast<std::ptrdiff_t>(chunkEnds[k]));
+                merged = chunkEnds[k];
+            }
+
+            std::vector<std::uint32_t> order(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                order[i] = keys[i].index;
+            }
+            return order;
+        }
+    };
+}
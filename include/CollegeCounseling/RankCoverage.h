@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "AllocationStrategy.h"
+#include "HugePages.h"
+
+namespace CollegeCounseling {
+    // Coverage filter over a seat matrix's rank domain, answering "no college" without touching
+    // the interval index. One bit per block of 2^blockShift ranks is set when any interval covers
+    // a rank in the block. The block is a single rank (the filter is exact) unless the domain
+    // exceeds maxBits ranks; then it widens just enough to stay within maxBits, and only ranks
+    // in wholly uncovered blocks are rejected, so a miss next to a covered rank in the same block
+    // still needs the index. Until built, the filter passes every rank.
+    class RankCoverage {
+    private:
+        bool built = false;
+        HugeVector<std::uint64_t> bits;
+        int base = 0;
+        std::uint64_t span = 0;
+        int blockShift = 0;
+
+    public:
+        // Largest bitmap kept (16MB)
+        static constexpr std::uint64_t maxBits = std::uint64_t(1) << 27;
+
+        // Builds the filter from elementary segments: segment k covers [starts[k], starts[k + 1])
+        // (the last one runs to the largest int) and is uncovered when ids[k] is noCollegeId
+        void build(const HugeVector<int>& starts, const HugeVector<std::int32_t>& ids) {
+            built = true;
+            bits.clear();
+            span = 0;
+            blockShift = 0;
+            if (starts.empty()) {
+                return;
+            }
+            std::int64_t end = ids.back() == AllocationStrategy::noCollegeId ? starts.back()
+                                                                             : static_cast<std::int64_t>(std::numeric_limits<int>::max()) + 1;
+            base = starts.front();
+            span = static_cast<std::uint64_t>(end - base);
+            if (span == 0) {
+                return;
+            }
+            while ((span >> blockShift) > maxBits) {
+                ++blockShift;
+            }
+            std::uint64_t blocks = ((span - 1) >> blockShift) + 1;
+            bits.assign(static_cast<size_t>((blocks + 63) / 64), 0);
+            for (size_t k = 0; k < starts.size(); ++k) {
+                if (ids[k] == AllocationStrategy::noCollegeId) {
+                    continue;
+                }
+                std::int64_t segmentEnd = k + 1 < starts.size() ? starts[k + 1] : end;
+                std::uint64_t first = static_cast<std::uint64_t>(static_cast<std::int64_t>(starts[k]) - base) >> blockShift;
+                std::uint64_t last = static_cast<std::uint64_t>(segmentEnd - 1 - base) >> blockShift;
+                setRange(first, last);
+            }
+        }
+
+        // False only when no interval covers the rank
+        bool mayCover(int rank) const {
+            if (!built) {
+                return true;
+            }
+            std::uint64_t offset = static_cast<std::uint64_t>(static_cast<std::int64_t>(rank) - base);
+            if (offset >= span) {
+                return false;
+            }
+            offset >>= blockShift;
+            return (bits[static_cast<size_t>(offset / 64)] >> (offset % 64)) & 1;
+        }
+
+        bool isBuilt() const {
+            return built;
+        }
+
+        // Whether a set bit also proves the rank is covered
+        bool isExact() const {
+            return blockShift == 0;
+        }
+
+        size_t getMemoryBytes() const {
+            return bits.capacity() * sizeof(std::uint64_t);
+        }
+
+    private:
+        // Sets blocks [first, last], whole words at a time in the middle
+        void setRange(std::uint64_t first, std::uint64_t last) {
+            size_t firstWord = static_cast<size_t>(first / 64);
+            size_t lastWord = static_cast<size_t>(last / 64);
+            std::uint64_t headMask = ~std::uint64_t(0) << (first % 64);
+            std::uint64_t tailMask = ~std::uint64_t(0) >> (63 - last % 64);
+            if (firstWord == lastWord) {
+                bits[firstWord] |= headMask & tailMask;
+                return;
+            }
+            bits[firstWord] |= headMask;
+            for (size_t w = firstWord + 1; w < lastWord; ++w) {
+                bits[w] = ~std::uint64_t(0);
+            }
+            bits[lastWord] |= tailMask;
+        }
+    };
+}
@@ -0,0 +1,861 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "Bits.h"
+#include "CollegeNameHash.h"
+#include "CollegeNamePool.h"
+#include "HugePages.h"
+#include "MappedFile.h"
+#include "RankCoverage.h"
+#include "SectionedSnapshot.h"
+
+namespace CollegeCounseling {
+    // Derived class implementing an allocation strategy based on rank intervals
+    class RankIntervalStrategy : public AllocationStrategy {
+    private:
+        // Structure to hold data about colleges and rank intervals
+        struct CollegeData {
+            int rankStart;
+            int rankEnd;
+            const std::string* college;
+        };
+
+        // Storage of the college names, private to this table unless a shared pool is given
+        std::shared_ptr<CollegeNamePool> namePool;
+
+        // Vector to store college data; a college's ID is its index in this vector
+        std::vector<CollegeData> collegesData;
+
+        // Checksum of the loaded table, recorded with every journaled decision
+        std::uint32_t snapshotVersion = 2166136261u;
+
+        // Name to ID lookup over the interned college names
+        CollegeNameHash nameHash;
+
+        // Sorted index: the table split into elementary segments, each starting at
+        // segmentStarts[i] and owned by the first row (lowest ID) covering it
+        HugeVector<int> segmentStarts;
+        HugeVector<std::int32_t> segmentIds;
+
+        // Dense rank -> ID table over [denseBase, denseBase + size) when the rank domain is at
+        // most denseRankLimit ranks
+        HugeVector<std::int32_t> denseTable;
+        int denseBase = 0;
+        std::int64_t denseRankLimit;
+
+        // Coverage filter rejecting uncovered ranks before the segment search. Misses are O(1)
+        // only where a structure answers them: the dense table (domains up to denseRankLimit),
+        // or this filter, which is built only past that limit and for at least
+        // coverageMinSegments segments. Smaller wide-domain indexes search for misses too, within
+        // a few cache lines, and past RankCoverage::maxBits ranks the filter is per block, so
+        // misses inside a partly covered block also fall through to the search.
+        RankCoverage coverage;
+
+        // Band index: IDs of the non-empty rows ordered by (rankStart, ID), their starts, and a
+        // max-end tree over that order (leaf leaves + i holds the rankEnd of order[i], each inner
+        // node the larger of its children) that finds the next interval reaching a rank in O(log n)
+        struct BandIndex {
+            HugeVector<std::int32_t> order;
+            HugeVector<int> starts;
+            HugeVector<int> maxEndTree;
+            size_t leaves = 0;
+        };
+        BandIndex band;
+
+        // State of a sectioned snapshot, which keeps its mapping open and parses a section the
+        // first time a query needs it. Loaded sections are published through their flag; the
+        // whole-table index and name hash are only built if something asks for them.
+        struct SectionPager {
+            MappedFile file;
+            std::vector<SnapshotSection> sections;
+            // Section indexes ordered by rankMin, with the running maximum of rankMax
+            std::vector<std::uint32_t> byRankMin;
+            std::vector<int> maxRankEnd;
+            // Rows of every ID; a row is valid once its section is loaded
+            std::vector<CollegeData> rows;
+            std::vector<HugeVector<int>> sectionStarts;
+            std::vector<HugeVector<std::int32_t>> sectionIds;
+            std::vector<BandIndex> sectionBands;
+            std::unique_ptr<std::atomic<bool>[]> loaded;
+            std::atomic<size_t> loadedCount{ 0 };
+            std::mutex loadMutex;
+
+            // The whole-table members are written once inside fullIndexOnce, without loadMutex;
+            // fullIndexBuilt publishes them to readers that do not go through the once flag
+            std::once_flag fullIndexOnce;
+            std::atomic<bool> fullIndexBuilt{ false };
+            HugeVector<int> fullStarts;
+            HugeVector<std::int32_t> fullIds;
+            CollegeNameHash fullNameHash;
+        };
+        std::unique_ptr<SectionPager> pager;
+
+        // Static member to track the total number of instances
+        static int totalInstances;
+
+    public:
+        // Parameterized constructor, loads college data from a file
+        RankIntervalStrategy(const std::string& dataFile) : RankIntervalStrategy(MappedFile::open(dataFile)) {}
+
+        // Loads college data from an already opened file; the mapping is released once parsed.
+        // A sectioned snapshot instead keeps the mapping and only reads its section index here.
+        // Names go into the given pool, so tables loaded into one pool share repeated names.
+        // A dense table is built for rank domains of at most denseRanks ranks (0 never builds one).
+        explicit RankIntervalStrategy(MappedFile dataFile, std::shared_ptr<CollegeNamePool> names = nullptr,
+                                      std::int64_t denseRanks = denseTableLimit)
+            : namePool(names ? std::move(names) : std::make_shared<CollegeNamePool>()),
+              denseRankLimit(std::min(denseRanks, denseTableLimit)) {
+            if (isSectionedSnapshot(dataFile)) {
+                openSections(std::move(dataFile));
+            } else {
+                loadCollegesData(dataFile);
+                buildNameHash();
+                buildRankIndex();
+                buildBandIndex(collegesData.data(), 0, collegesData.size(), band);
+            }
+            totalInstances++;
+        }
+
+        // Delegating constructor, uses a default data file
+        RankIntervalStrategy() : RankIntervalStrategy("default_data.txt") {}
+
+        // Override of the virtual function to allocate a college based on rank
+        std::string allocateCollege(int userRank) const override {
+            int collegeId = allocateCollegeId(userRank);
+            if (collegeId == noCollegeId) {
+                return "No college allocated for your rank.";
+            }
+            return *row(collegeId).college;
+        }
+
+        // Override returning the index of the first interval covering the rank
+        int allocateCollegeId(int userRank) const override {
+            if (pager) {
+                return sectionedCollegeId(userRank);
+            }
+            if (!denseTable.empty()) {
+                std::uint64_t offset = static_cast<std::uint64_t>(static_cast<std::int64_t>(userRank) - denseBase);
+                return offset < denseTable.size() ? denseTable[static_cast<size_t>(offset)] : noCollegeId;
+            }
+            if (!coverage.mayCover(userRank)) {
+                return noCollegeId;
+            }
+            return findInSegments(segmentStarts, segmentIds, userRank);
+        }
+
+        // Batched lookup overlapping the memory latency of independent queries. Dense tables are
+        // prefetched a fixed distance ahead. Binary searches run in lockstep groups: each step
+        // first prefetches both possible next probes of every query in the group, then advances
+        // them all, so one query's cache miss is hidden behind the others' work.
+        void allocateCollegeIds(const std::int32_t* userRanks, std::int32_t* collegeIds, size_t count) const override {
+            if (pager) {
+                for (size_t i = 0; i < count; ++i) {
+                    collegeIds[i] = sectionedCollegeId(userRanks[i]);
+                }
+                return;
+            }
+            if (!denseTable.empty()) {
+                const size_t distance = 16;
+                for (size_t i = 0; i < count; ++i) {
+                    if (i + distance < count) {
+                        std::uint64_t ahead = static_cast<std::uint64_t>(static_cast<std::int64_t>(userRanks[i + distance]) - denseBase);
+                        if (ahead < denseTable.size()) {
+                            prefetchRead(denseTable.data() + ahead);
+                        }
+                    }
+                    std::uint64_t offset = static_cast<std::uint64_t>(static_cast<std::int64_t>(userRanks[i]) - denseBase);
+                    collegeIds[i] = offset < denseTable.size() ? denseTable[static_cast<size_t>(offset)] : noCollegeId;
+                }
+                return;
+            }
+            if (segmentStarts.empty()) {
+                std::fill(collegeIds, collegeIds + count, noCollegeId);
+                return;
+            }
+
+            // Ranks the coverage filter rejects are answered at once; the rest fill the groups
+            const size_t groupSize = 16;
+            const int* starts = segmentStarts.data();
+            size_t base[groupSize];
+            size_t slots[groupSize];
+            std::int32_t ranks[groupSize];
+            size_t members = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (!coverage.mayCover(userRanks[i])) {
+                    collegeIds[i] = noCollegeId;
+                } else {
+                    slots[members] = i;
+                    ranks[members] = userRanks[i];
+                    base[members] = 0;
+                    ++members;
+                }
+                if (members < groupSize && i + 1 < count) {
+                    continue;
+                }
+                for (size_t remaining = segmentStarts.size(); remaining > 1;) {
+                    size_t half = remaining / 2;
+                    for (size_t g = 0; g < members; ++g) {
+                        prefetchRead(starts + base[g] + half / 2);
+                        prefetchRead(starts + base[g] + half + half / 2);
+                    }
+                    for (size_t g = 0; g < members; ++g) {
+                        base[g] = starts[base[g] + half] <= ranks[g] ? base[g] + half : base[g];
+                    }
+                    remaining -= half;
+                }
+                for (size_t g = 0; g < members; ++g) {
+                    collegeIds[slots[g]] = starts[base[g]] <= ranks[g] ? segmentIds[base[g]] : noCollegeId;
+                }
+                members = 0;
+            }
+        }
+
+        // Boundaries of the elementary segments, ascending (loads every section of a sectioned snapshot)
+        const HugeVector<int>& getSegmentStarts() const {
+            return pager ? fullSectionIndex().fullStarts : segmentStarts;
+        }
+
+        // Owning college ID of each segment, noCollegeId for gaps
+        const HugeVector<std::int32_t>& getSegmentIds() const {
+            return pager ? fullSectionIndex().fullIds : segmentIds;
+        }
+
+        // One interval yielded by a band scan
+        struct BandInterval {
+            int collegeId;
+            int rankStart;
+            int rankEnd;
+            const std::string* college;
+        };
+
+        // Forward iterator over the intervals overlapping a rank band, in (rankStart, ID) order
+        class BandIterator {
+        private:
+            const BandIndex* index = nullptr;
+            const CollegeData* rows = nullptr;
+            size_t position = 0;
+            size_t end = 0;
+            int firstRank = 0;
+
+            // Steps over intervals that start before the band and end before it too
+            void skipDisjoint() {
+                if (position < end && rows[index->order[position]].rankEnd < firstRank) {
+                    position = std::min(end, nextReaching(*index, position, firstRank));
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = BandInterval;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const BandInterval*;
+            using reference = BandInterval;
+
+            BandIterator() = default;
+
+            BandIterator(const BandIndex& bandIndex, const CollegeData* tableRows, size_t first, size_t last, int bandStart)
+                : index(&bandIndex), rows(tableRows), position(first), end(last), firstRank(bandStart) {
+                skipDisjoint();
+            }
+
+            BandInterval operator*() const {
+                std::int32_t id = index->order[position];
+                return { id, rows[id].rankStart, rows[id].rankEnd, rows[id].college };
+            }
+
+            BandIterator& operator++() {
+                ++position;
+                skipDisjoint();
+                return *this;
+            }
+
+            BandIterator operator++(int) {
+                BandIterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const BandIterator& other) const {
+                return position == other.position;
+            }
+
+            bool operator!=(const BandIterator& other) const {
+                return position != other.position;
+            }
+        };
+
+        // Range of a band scan, for use in range-based for loops. A sectioned snapshot's band
+        // owns the index its iterators walk, so they are valid only while the band is.
+        class RankBand {
+        private:
+            std::shared_ptr<const BandIndex> owned;
+            BandIterator first;
+            BandIterator last;
+
+        public:
+            RankBand(BandIterator begin, BandIterator end, std::shared_ptr<const BandIndex> index = nullptr)
+                : owned(std::move(index)), first(begin), last(end) {}
+
+            BandIterator begin() const {
+                return first;
+            }
+
+            BandIterator end() const {
+                return last;
+            }
+        };
+
+        // Intervals overlapping ranks [firstRank, lastRank], streamed in (rankStart, ID) order.
+        // A binary search over the starts bounds the scan at the last row starting at or before
+        // lastRank, and the max-end tree jumps from each reported row to the next one reaching
+        // firstRank, so intervals nested under earlier ones cost nothing: O((k + 1) log n) for k
+        // results. A sectioned snapshot loads only the sections whose rank range overlaps the
+        // band and merges their band indexes into one owned by the result, which costs
+        // O(m log m) for the m intervals of those sections that overlap it.
+        RankBand scanBand(int firstRank, int lastRank) const {
+            if (pager) {
+                return sectionedBand(firstRank, lastRank);
+            }
+            return bandOf(band, collegesData.data(), firstRank, lastRank, nullptr);
+        }
+
+        // Pool holding the college names
+        const std::shared_ptr<CollegeNamePool>& getNamePool() const {
+            return namePool;
+        }
+
+        // Bytes held by this table's rows and indexes, excluding the (possibly shared) name pool
+        size_t getIndexBytes() const {
+            size_t bytes = collegesData.capacity() * sizeof(CollegeData) + nameHash.getMemoryBytes()
+                         + segmentStarts.capacity() * sizeof(int) + segmentIds.capacity() * sizeof(std::int32_t)
+                         + denseTable.capacity() * sizeof(std::int32_t) + coverage.getMemoryBytes() + bandBytes(band);
+            if (pager) {
+                std::lock_guard<std::mutex> lock(pager->loadMutex);
+                bytes += pager->rows.capacity() * sizeof(CollegeData) + pager->sections.capacity() * sizeof(SnapshotSection);
+                if (pager->fullIndexBuilt.load(std::memory_order_acquire)) {
+                    bytes += pager->fullNameHash.getMemoryBytes() + pager->fullStarts.capacity() * sizeof(int)
+                           + pager->fullIds.capacity() * sizeof(std::int32_t);
+                }
+                for (size_t s = 0; s < pager->sections.size(); ++s) {
+                    bytes += pager->sectionStarts[s].capacity() * sizeof(int) + pager->sectionIds[s].capacity() * sizeof(std::int32_t)
+                           + bandBytes(pager->sectionBands[s]);
+                }
+            }
+            return bytes;
+        }
+
+        // Number of entries in the college table
+        int getCollegeCount() const {
+            return static_cast<int>(pager ? pager->rows.size() : collegesData.size());
+        }
+
+        // Name of the college with the given ID
+        const std::string& getCollegeName(int collegeId) const {
+            return *row(collegeId).college;
+        }
+
+        // ID of a college by name (surrounding spaces ignored), or noCollegeId when unknown.
+        // Loads every section of a sectioned snapshot.
+        int findCollegeId(const std::string& collegeName) const {
+            return pager ? fullSectionIndex().fullNameHash.find(collegeName) : nameHash.find(collegeName);
+        }
+
+        // Rank interval [start, end] of a college
+        std::pair<int, int> getRankInterval(int collegeId) const {
+            const CollegeData& data = row(collegeId);
+            return { data.rankStart, data.rankEnd };
+        }
+
+        // Seats offered by a college: one per rank in its interval
+        int getCollegeCapacity(int collegeId) const {
+            const CollegeData& data = row(collegeId);
+            return data.rankEnd - data.rankStart + 1;
+        }
+
+        // Coverage filter of a plain table; not built (passing every rank) unless the table has
+        // a wide domain and many segments
+        const RankCoverage& getCoverage() const {
+            return coverage;
+        }
+
+        // Sections of a sectioned snapshot (0 for a plain table) and how many are parsed so far
+        size_t getSectionCount() const {
+            return pager ? pager->sections.size() : 0;
+        }
+
+        size_t getLoadedSectionCount() const {
+            return pager ? pager->loadedCount.load() : 0;
+        }
+
+        // Writes the table as a sectioned snapshot of rowsPerSection consecutive IDs per section
+        void writeSectioned(std::ostream& out, size_t rowsPerSection) const {
+            if (rowsPerSection == 0) {
+                throw std::runtime_error("Error: Sections need at least one row.");
+            }
+            size_t collegeCount = static_cast<size_t>(getCollegeCount());
+            std::vector<SnapshotSection> sections;
+            std::string body;
+            for (size_t first = 0; first < collegeCount; first += rowsPerSection) {
+                SnapshotSection section{ std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min(),
+                                         static_cast<std::int32_t>(first), 0, body.size(), 0 };
+                for (size_t id = first; id < std::min(collegeCount, first + rowsPerSection); ++id) {
+                    const CollegeData& data = row(static_cast<int>(id));
+                    body += std::to_string(data.rankStart) + "-" + std::to_string(data.rankEnd) + ":" + *data.college + "\n";
+                    ++section.rowCount;
+                    if (data.rankStart <= data.rankEnd) {
+                        section.rankMin = std::min(section.rankMin, data.rankStart);
+                        section.rankMax = std::max(section.rankMax, data.rankEnd);
+                    }
+                }
+                section.length = body.size() - section.offset;
+                sections.push_back(section);
+            }
+
+            SectionedSnapshotHeader header{ {}, sectionedSnapshotFormat, snapshotVersion, static_cast<std::uint32_t>(collegeCount),
+                                            static_cast<std::uint32_t>(sections.size()), 0 };
+            std::memcpy(header.magic, sectionedSnapshotMagic, sizeof(header.magic));
+            std::uint64_t bodyOffset = sizeof(header) + sections.size() * sizeof(SnapshotSection);
+            for (SnapshotSection& section : sections) {
+                section.offset += bodyOffset;
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(sections.data()), static_cast<std::streamsize>(sections.size() * sizeof(SnapshotSection)));
+            out.write(body.data(), static_cast<std::streamsize>(body.size()));
+            if (!out) {
+                throw std::runtime_error("Error: Cannot write sectioned snapshot.");
+            }
+        }
+
+        // Version of the loaded table, changes whenever the data file does
+        std::uint32_t getSnapshotVersion() const {
+            return snapshotVersion;
+        }
+
+        // Static method to get the total number of instances
+        static int getTotalInstances() {
+            return totalInstances;
+        }
+
+    private:
+        // Private method to load colleges data from a file
+        void loadCollegesData(const MappedFile& buffer) {
+            parseRows(buffer.data(), buffer.size(), collegesData, &snapshotVersion);
+        }
+
+        // Appends the rows of a block of data lines, interning their names in one batch, and
+        // folds the lines into the checksum when one is given
+        void parseRows(const char* data, size_t size, std::vector<CollegeData>& rows, std::uint32_t* checksum) const {
+            // One vectorized pass finds every newline, colon and hyphen in the block
+            std::vector<size_t> structural;
+            ByteScanner::findAll(data, size, "\n:-", structural);
+            structural.push_back(size);
+
+            // Names are collected as views into the file and interned in one batch
+            size_t firstRow = rows.size();
+            std::vector<std::string_view> names;
+            size_t lineStart = 0;
+            size_t colonPos = std::string::npos;
+            size_t hyphenPos = std::string::npos;
+            for (size_t position : structural) {
+                char c = position < size ? data[position] : '\n';
+                if (c == ':' && colonPos == std::string::npos) {
+                    colonPos = position;
+                } else if (c == '-' && colonPos == std::string::npos && hyphenPos == std::string::npos) {
+                    hyphenPos = position;
+                } else if (c == '\n') {
+                    parseLine(data, lineStart, position, colonPos, hyphenPos, rows, names, checksum);
+                    lineStart = position + 1;
+                    colonPos = std::string::npos;
+                    hyphenPos = std::string::npos;
+                }
+            }
+
+            std::vector<const std::string*> pooled;
+            namePool->internAll(names, pooled);
+            for (size_t i = 0; i < pooled.size(); ++i) {
+                rows[firstRow + i].college = pooled[i];
+            }
+        }
+
+        // Parses one "start-end: college" line from its pre-located colon and hyphen.
+        // Blank lines and "//" comment lines are skipped, a trailing carriage return is dropped.
+        static void parseLine(const char* data, size_t lineStart, size_t lineEnd, size_t colonPos, size_t hyphenPos,
+                              std::vector<CollegeData>& rows, std::vector<std::string_view>& names, std::uint32_t* checksum) {
+            if (lineEnd > lineStart && data[lineEnd - 1] == '\r') {
+                --lineEnd;
+            }
+            if (lineEnd == lineStart || (lineEnd - lineStart >= 2 && data[lineStart] == '/' && data[lineStart + 1] == '/')) {
+                return;
+            }
+            if (colonPos == std::string::npos || colonPos >= lineEnd) {
+                throw std::runtime_error("Error: Invalid data format in the data file.");
+            }
+            if (hyphenPos == std::string::npos) {
+                throw std::runtime_error("Error: Invalid rank range in the data file.");
+            }
+
+            // Extracting rank start and end values
+            int rankStart = parseRank(data + lineStart, data + hyphenPos);
+            int rankEnd = parseRank(data + hyphenPos + 1, data + colonPos);
+
+            // Adding college data to the vector
+            rows.push_back({ rankStart, rankEnd, nullptr });
+            names.emplace_back(data + colonPos + 1, lineEnd - colonPos - 1);
+            if (checksum) {
+                updateSnapshotVersion(*checksum, data + lineStart, lineEnd - lineStart);
+            }
+        }
+
+        // Reads a rank, allowing surrounding spaces like std::stoi did
+        static int parseRank(const char* first, const char* last) {
+            while (first < last && (*first == ' ' || *first == '\t')) {
+                ++first;
+            }
+            int value = 0;
+            std::from_chars_result parsed = std::from_chars(first, last, value);
+            if (parsed.ec != std::errc()) {
+                throw std::runtime_error("Error: Invalid rank range in the data file.");
+            }
+            return value;
+        }
+
+        // Builds the perfect hash over the loaded names
+        void buildNameHash() {
+            std::vector<std::string_view> names;
+            names.reserve(collegesData.size());
+            for (const CollegeData& data : collegesData) {
+                names.push_back(*data.college);
+            }
+            nameHash.build(names);
+        }
+
+        // Largest rank domain given a dense table (64MB of IDs)
+        static constexpr std::int64_t denseTableLimit = std::int64_t(1) << 24;
+
+        // Fewest segments given a coverage filter; below this the search touches only a few cache lines
+        static constexpr size_t coverageMinSegments = size_t(1) << 14;
+
+        // Splits the table into elementary segments keeping first-match semantics, then adds a
+        // dense table when the covered rank domain is small
+        void buildRankIndex() {
+            buildSegments(collegesData.data(), collegesData.size(), 0, segmentStarts, segmentIds);
+
+            if (segmentStarts.size() < 2) {
+                return;
+            }
+            std::int64_t domain = static_cast<std::int64_t>(segmentStarts.back()) - segmentStarts.front();
+            if (domain > denseRankLimit) {
+                if (segmentStarts.size() >= coverageMinSegments) {
+                    coverage.build(segmentStarts, segmentIds);
+                }
+                return;
+            }
+            denseBase = segmentStarts.front();
+            denseTable.resize(static_cast<size_t>(domain));
+            for (size_t k = 0; k + 1 < segmentStarts.size(); ++k) {
+                std::fill(denseTable.begin() + (segmentStarts[k] - denseBase), denseTable.begin() + (segmentStarts[k + 1] - denseBase),
+                          segmentIds[k]);
+            }
+        }
+
+        // Segments of rows [0, count) whose IDs start at firstId, with first-match semantics
+        static void buildSegments(const CollegeData* rows, size_t count, int firstId, HugeVector<int>& starts,
+                                  HugeVector<std::int32_t>& ids) {
+            std::vector<std::pair<std::int64_t, int>> events;
+            events.reserve(count * 2);
+            for (size_t i = 0; i < count; ++i) {
+                if (rows[i].rankStart > rows[i].rankEnd) {
+                    continue;
+                }
+                int id = firstId + static_cast<int>(i);
+                events.emplace_back(rows[i].rankStart, id);
+                events.emplace_back(static_cast<std::int64_t>(rows[i].rankEnd) + 1, -1 - id);
+            }
+            std::sort(events.begin(), events.end());
+
+            std::set<int> active;
+            for (size_t i = 0; i < events.size();) {
+                std::int64_t boundary = events[i].first;
+                for (; i < events.size() && events[i].first == boundary; ++i) {
+                    if (events[i].second >= 0) {
+                        active.insert(events[i].second);
+                    } else {
+                        active.erase(-1 - events[i].second);
+                    }
+                }
+                if (boundary > std::numeric_limits<int>::max()) {
+                    break;
+                }
+                std::int32_t owner = active.empty() ? noCollegeId : *active.begin();
+                if (ids.empty() || ids.back() != owner) {
+                    starts.push_back(static_cast<int>(boundary));
+                    ids.push_back(owner);
+                }
+            }
+        }
+
+        // Segment lookup shared by the plain index and each loaded section
+        static int findInSegments(const HugeVector<int>& starts, const HugeVector<std::int32_t>& ids, int userRank) {
+            auto segment = std::upper_bound(starts.begin(), starts.end(), userRank);
+            if (segment == starts.begin()) {
+                return noCollegeId;
+            }
+            return ids[static_cast<size_t>(segment - starts.begin()) - 1];
+        }
+
+        // Reads the header and section index of a sectioned snapshot; no section is parsed yet
+        void openSections(MappedFile file) {
+            SectionedSnapshotHeader header;
+            std::memcpy(&header, file.data(), sizeof(header));
+            std::uint64_t indexEnd = sizeof(header) + static_cast<std::uint64_t>(header.sectionCount) * sizeof(SnapshotSection);
+            if (header.formatVersion != sectionedSnapshotFormat || indexEnd > file.size()) {
+                throw std::runtime_error("Error: Corrupt sectioned snapshot " + file.getPath());
+            }
+
+            auto state = std::make_unique<SectionPager>();
+            state->sections.resize(header.sectionCount);
+            std::memcpy(state->sections.data(), file.data() + sizeof(header), header.sectionCount * sizeof(SnapshotSection));
+            std::int64_t nextId = 0;
+            for (const SnapshotSection& section : state->sections) {
+                if (section.firstId != nextId || section.rowCount < 0 || section.offset < indexEnd
+                    || section.offset > file.size() || section.length > file.size() - section.offset) {
+                    throw std::runtime_error("Error: Corrupt sectioned snapshot " + file.getPath());
+                }
+                nextId += section.rowCount;
+            }
+            if (nextId != header.collegeCount) {
+                throw std::runtime_error("Error: Corrupt sectioned snapshot " + file.getPath());
+            }
+
+            for (std::uint32_t s = 0; s < header.sectionCount; ++s) {
+                if (state->sections[s].rankMin <= state->sections[s].rankMax) {
+                    state->byRankMin.push_back(s);
+                }
+            }
+            std::sort(state->byRankMin.begin(), state->byRankMin.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return state->sections[a].rankMin < state->sections[b].rankMin;
+            });
+            for (std::uint32_t s : state->byRankMin) {
+                int previous = state->maxRankEnd.empty() ? std::numeric_limits<int>::min() : state->maxRankEnd.back();
+                state->maxRankEnd.push_back(std::max(previous, state->sections[s].rankMax));
+            }
+
+            state->rows.assign(header.collegeCount, CollegeData{ 0, -1, nullptr });
+            state->sectionStarts.resize(header.sectionCount);
+            state->sectionIds.resize(header.sectionCount);
+            state->sectionBands.resize(header.sectionCount);
+            state->loaded = std::make_unique<std::atomic<bool>[]>(header.sectionCount);
+            // Sections are read where queries land, so sequential readahead would only pull in
+            // sections nobody asked for
+            file.advise(MappedFile::Access::Random);
+            state->file = std::move(file);
+            snapshotVersion = header.snapshotVersion;
+            pager = std::move(state);
+        }
+
+        // Parses a section on its first use; later calls only check its flag
+        void loadSection(size_t s) const {
+            SectionPager& state = *pager;
+            if (state.loaded[s].load(std::memory_order_acquire)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(state.loadMutex);
+            if (state.loaded[s].load(std::memory_order_relaxed)) {
+                return;
+            }
+            const SnapshotSection& section = state.sections[s];
+            std::vector<CollegeData> parsed;
+            parsed.reserve(static_cast<size_t>(section.rowCount));
+            parseRows(state.file.data() + section.offset, static_cast<size_t>(section.length), parsed, nullptr);
+            if (parsed.size() != static_cast<size_t>(section.rowCount)) {
+                throw std::runtime_error("Error: Corrupt sectioned snapshot " + state.file.getPath());
+            }
+            std::copy(parsed.begin(), parsed.end(), state.rows.begin() + section.firstId);
+            buildSegments(parsed.data(), parsed.size(), section.firstId, state.sectionStarts[s], state.sectionIds[s]);
+            buildBandIndex(state.rows.data(), section.firstId, parsed.size(), state.sectionBands[s]);
+            state.loadedCount.fetch_add(1, std::memory_order_relaxed);
+            state.loaded[s].store(true, std::memory_order_release);
+        }
+
+        // First-match lookup over the sections whose rank range can hold the rank. Candidates are
+        // the sections with rankMin <= rank, walked back while the running rankMax still reaches
+        // it; a section starting past the best ID found so far cannot improve on it.
+        int sectionedCollegeId(int userRank) const {
+            const SectionPager& state = *pager;
+            auto end = std::upper_bound(state.byRankMin.begin(), state.byRankMin.end(), userRank,
+                                        [&](int rank, std::uint32_t s) { return rank < state.sections[s].rankMin; });
+            int best = noCollegeId;
+            for (size_t k = static_cast<size_t>(end - state.byRankMin.begin()); k > 0 && state.maxRankEnd[k - 1] >= userRank; --k) {
+                std::uint32_t s = state.byRankMin[k - 1];
+                const SnapshotSection& section = state.sections[s];
+                if (section.rankMax < userRank || (best != noCollegeId && section.firstId > best)) {
+                    continue;
+                }
+                loadSection(s);
+                int id = findInSegments(state.sectionStarts[s], state.sectionIds[s], userRank);
+                if (id != noCollegeId && (best == noCollegeId || id < best)) {
+                    best = id;
+                }
+            }
+            return best;
+        }
+
+        // Row of an ID, loading its section first for a sectioned snapshot
+        const CollegeData& row(int collegeId) const {
+            if (!pager) {
+                return collegesData.at(collegeId);
+            }
+            if (collegeId < 0 || static_cast<size_t>(collegeId) >= pager->rows.size()) {
+                throw std::out_of_range("Error: College ID out of range.");
+            }
+            auto section = std::upper_bound(pager->sections.begin(), pager->sections.end(), collegeId,
+                                             [](int id, const SnapshotSection& entry) { return id < entry.firstId; });
+            loadSection(static_cast<size_t>(section - pager->sections.begin()) - 1);
+            return pager->rows[static_cast<size_t>(collegeId)];
+        }
+
+        // Orders the non-empty rows with IDs [firstId, firstId + count) by (rankStart, ID); rows is
+        // indexed by ID, and rows already in start order skip the sort
+        static void buildBandIndex(const CollegeData* rows, int firstId, size_t count, BandIndex& index) {
+            for (std::int32_t id = firstId; id < firstId + static_cast<std::int32_t>(count); ++id) {
+                if (rows[id].rankStart <= rows[id].rankEnd) {
+                    index.order.push_back(id);
+                }
+            }
+            auto byStart = [&](std::int32_t a, std::int32_t b) {
+                return rows[a].rankStart < rows[b].rankStart || (rows[a].rankStart == rows[b].rankStart && a < b);
+            };
+            if (!std::is_sorted(index.order.begin(), index.order.end(), byStart)) {
+                std::sort(index.order.begin(), index.order.end(), byStart);
+            }
+            finishBandIndex(rows, index);
+        }
+
+        // Fills the starts and max-end tree of an index whose order is set; rows is indexed by ID
+        static void finishBandIndex(const CollegeData* rows, BandIndex& index) {
+            index.starts.resize(index.order.size());
+            index.leaves = 1;
+            while (index.leaves < index.order.size()) {
+                index.leaves *= 2;
+            }
+            index.maxEndTree.assign(2 * index.leaves, std::numeric_limits<int>::min());
+            for (size_t i = 0; i < index.order.size(); ++i) {
+                const CollegeData& data = rows[index.order[i]];
+                index.starts[i] = data.rankStart;
+                index.maxEndTree[index.leaves + i] = data.rankEnd;
+            }
+            for (size_t node = index.leaves - 1; node > 0; --node) {
+                index.maxEndTree[node] = std::max(index.maxEndTree[2 * node], index.maxEndTree[2 * node + 1]);
+            }
+        }
+
+        // First position at or after the given one whose interval reaches the rank, or the
+        // order size when none does: climbs until a right sibling holds one, then descends to it
+        static size_t nextReaching(const BandIndex& index, size_t position, int rank) {
+            if (position >= index.order.size()) {
+                return index.order.size();
+            }
+            size_t node = index.leaves + position;
+            if (index.maxEndTree[node] >= rank) {
+                return position;
+            }
+            while (node > 1 && ((node & 1) != 0 || index.maxEndTree[node + 1] < rank)) {
+                node >>= 1;
+            }
+            if (node == 1) {
+                return index.order.size();
+            }
+            for (++node; node < index.leaves;) {
+                node = index.maxEndTree[2 * node] >= rank ? 2 * node : 2 * node + 1;
+            }
+            return node - index.leaves;
+        }
+
+        // Band over one index; the owner, if any, keeps a merged index alive with the band
+        static RankBand bandOf(const BandIndex& index, const CollegeData* rows, int firstRank, int lastRank,
+                               std::shared_ptr<const BandIndex> owner) {
+            size_t last = static_cast<size_t>(std::upper_bound(index.starts.begin(), index.starts.end(), lastRank) - index.starts.begin());
+            size_t first = firstRank > lastRank ? last : std::min(last, nextReaching(index, 0, firstRank));
+            return RankBand(BandIterator(index, rows, first, last, firstRank), BandIterator(index, rows, last, last, firstRank),
+                            std::move(owner));
+        }
+
+        // Band of a sectioned snapshot: only sections whose [rankMin, rankMax] overlaps the band
+        // are loaded, and their overlapping intervals are merged into one index
+        RankBand sectionedBand(int firstRank, int lastRank) const {
+            const SectionPager& state = *pager;
+            auto merged = std::make_shared<BandIndex>();
+            if (firstRank <= lastRank) {
+                size_t k = static_cast<size_t>(std::lower_bound(state.maxRankEnd.begin(), state.maxRankEnd.end(), firstRank)
+                                               - state.maxRankEnd.begin());
+                for (; k < state.byRankMin.size() && state.sections[state.byRankMin[k]].rankMin <= lastRank; ++k) {
+                    std::uint32_t s = state.byRankMin[k];
+                    if (state.sections[s].rankMax < firstRank) {
+                        continue;
+                    }
+                    loadSection(s);
+                    for (const BandInterval& interval : bandOf(state.sectionBands[s], state.rows.data(), firstRank, lastRank, nullptr)) {
+                        merged->order.push_back(interval.collegeId);
+                    }
+                }
+            }
+            const CollegeData* rows = state.rows.data();
+            std::sort(merged->order.begin(), merged->order.end(), [&](std::int32_t a, std::int32_t b) {
+                return rows[a].rankStart < rows[b].rankStart || (rows[a].rankStart == rows[b].rankStart && a < b);
+            });
+            finishBandIndex(rows, *merged);
+            const BandIndex& index = *merged;
+            return bandOf(index, rows, firstRank, lastRank, std::move(merged));
+        }
+
+        static size_t bandBytes(const BandIndex& index) {
+            return index.order.capacity() * sizeof(std::int32_t) + (index.starts.capacity() + index.maxEndTree.capacity()) * sizeof(int);
+        }
+
+        // Whole-table segments and name hash of a sectioned snapshot, built once on demand
+        SectionPager& fullSectionIndex() const {
+            SectionPager& state = *pager;
+            std::call_once(state.fullIndexOnce, [&] {
+                std::vector<std::string_view> names;
+                names.reserve(state.rows.size());
+                for (size_t s = 0; s < state.sections.size(); ++s) {
+                    loadSection(s);
+                }
+                for (const CollegeData& data : state.rows) {
+                    names.push_back(*data.college);
+                }
+                buildSegments(state.rows.data(), state.rows.size(), 0, state.fullStarts, state.fullIds);
+                state.fullNameHash.build(names);
+                state.fullIndexBuilt.store(true, std::memory_order_release);
+            });
+            return state;
+        }
+
+        // Folds a data line into the FNV-1a snapshot checksum
+        static void updateSnapshotVersion(std::uint32_t& checksum, const char* line, size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                checksum = (checksum ^ static_cast<unsigned char>(line[i])) * 16777619u;
+            }
+            checksum = (checksum ^ '\n') * 16777619u;
+        }
+    };
+
+    // Initializing the static member of RankIntervalStrategy
+    inline int RankIntervalStrategy::totalInstances = 0;
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bits.h"
+
+namespace CollegeCounseling {
+    // Stores per-round allocation results as deltas against the previous round: a bitmap of
+    // the applicants whose college changed plus their new college IDs as LEB128 varints.
+    // Every keyframeInterval-th round is stored in full so materializing a late round only
+    // replays the deltas since the nearest keyframe.
+    class RoundDeltaStore {
+    private:
+        static constexpr char magic[4] = { 'C', 'C', 'D', 'S' };
+        static constexpr std::uint32_t formatVersion = 1;
+
+        // One encoded round; a keyframe has no bitmap and one varint per applicant
+        struct EncodedRound {
+            bool keyframe = false;
+            std::vector<std::uint64_t> changed;
+            std::vector<std::uint8_t> values;
+        };
+
+        size_t applicantCount = 0;
+        size_t keyframeInterval;
+        std::vector<EncodedRound> encodedRounds;
+        std::vector<std::int32_t> lastRound;
+
+    public:
+        explicit RoundDeltaStore(size_t keyframeEvery = 16)
+            : keyframeInterval(keyframeEvery == 0 ? 1 : keyframeEvery) {}
+
+        // Number of rounds stored so far
+        size_t getRoundCount() const {
+            return encodedRounds.size();
+        }
+
+        // Number of applicants in every round
+        size_t getApplicantCount() const {
+            return applicantCount;
+        }
+
+        // Encoded size in bytes, excluding the in-memory copy of the last round
+        size_t getEncodedBytes() const {
+            size_t bytes = 0;
+            for (const EncodedRound& round : encodedRounds) {
+                bytes += round.changed.size() * sizeof(std::uint64_t) + round.values.size();
+            }
+            return bytes;
+        }
+
+        // Encodes the next round; every round must cover the same applicants
+        void appendRound(const std::vector<std::int32_t>& result) {
+            if (encodedRounds.empty()) {
+                applicantCount = result.size();
+            } else if (result.size() != applicantCount) {
+                throw std::runtime_error("Error: Round result covers a different applicant set.");
+            }
+
+            EncodedRound encoded;
+            encoded.keyframe = encodedRounds.size() % keyframeInterval == 0;
+            if (encoded.keyframe) {
+                for (std::int32_t collegeId : result) {
+                    putVarint(encoded.values, collegeId);
+                }
+            } else {
+                encoded.changed.assign((applicantCount + 63) / 64, 0);
+                for (size_t i = 0; i < applicantCount; ++i) {
+                    if (result[i] != lastRound[i]) {
+                        encoded.changed[i / 64] |= std::uint64_t(1) << (i % 64);
+                        putVarint(encoded.values, result[i]);
+                    }
+                }
+            }
+            encodedRounds.push_back(std::move(encoded));
+            lastRound = result;
+        }
+
+        // Rebuilds the full result of a round (0-based) from its nearest keyframe
+        std::vector<std::int32_t> materialize(size_t round) const {
+            if (round >= encodedRounds.size()) {
+                throw std::runtime_error("Error: Round not present in the result store.");
+            }
+            std::vector<std::int32_t> result(applicantCount);
+            size_t first = round - round % keyframeInterval;
+            for (size_t r = first; r <= round; ++r) {
+                const EncodedRound& encoded = encodedRounds[r];
+                const std::uint8_t* cursor = encoded.values.data();
+                const std::uint8_t* end = cursor + encoded.values.size();
+                if (encoded.keyframe) {
+                    for (std::int32_t& collegeId : result) {
+                        collegeId = getVarint(cursor, end);
+                    }
+                } else {
+                    for (size_t word = 0; word < encoded.changed.size(); ++word) {
+                        std::uint64_t bits = encoded.changed[word];
+                        while (bits != 0) {
+                            size_t applicant = word * 64 + static_cast<size_t>(countTrailingZeros(bits));
+                            if (applicant >= applicantCount) {
+                                throw std::runtime_error("Error: Corrupt result store.");
+                            }
+                            result[applicant] = getVarint(cursor, end);
+                            bits &= bits - 1;
+                        }
+                    }
+                }
+                if (cursor != end) {
+                    throw std::runtime_error("Error: Corrupt result store.");
+                }
+            }
+            return result;
+        }
+
+        // Writes the encoded rounds to disk
+        void save(const std::string& path) const {
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            if (!output.is_open()) {
+                throw std::runtime_error("Error: Cannot write result store.");
+            }
+            std::uint64_t applicants = applicantCount, interval = keyframeInterval, rounds = encodedRounds.size();
+            output.write(magic, 4);
+            output.write(reinterpret_cast<const char*>(&formatVersion), 4);
+            output.write(reinterpret_cast<const char*>(&applicants), 8);
+            output.write(reinterpret_cast<const char*>(&interval), 8);
+            output.write(reinterpret_cast<const char*>(&rounds), 8);
+            for (const EncodedRound& round : encodedRounds) {
+                std::uint64_t valueBytes = round.values.size();
+                output.write(reinterpret_cast<const char*>(&valueBytes), 8);
+                if (!round.keyframe) {
+                    output.write(reinterpret_cast<const char*>(round.changed.data()),
+                                 static_cast<std::streamsize>(round.changed.size() * sizeof(std::uint64_t)));
+                }
+                output.write(reinterpret_cast<const char*>(round.values.data()), static_cast<std::streamsize>(valueBytes));
+            }
+            if (!output) {
+                throw std::runtime_error("Error: Cannot write result store.");
+            }
+        }
+
+        // Reads a store written by save(). Every size in the file is checked against the bytes
+        // left before it is allocated, each round must hold exactly one value per changed
+        // applicant (per applicant for a keyframe), and nothing may follow the last round.
+        static RoundDeltaStore load(const std::string& path) {
+            std::ifstream input(path, std::ios::binary | std::ios::ate);
+            if (!input.is_open()) {
+                throw std::runtime_error("Error: Cannot open result store.");
+            }
+            std::uint64_t remaining = static_cast<std::uint64_t>(input.tellg());
+            input.seekg(0);
+            char header[4];
+            std::uint32_t version = 0;
+            std::uint64_t applicants = 0, interval = 0, rounds = 0;
+            input.read(header, 4);
+            input.read(reinterpret_cast<char*>(&version), 4);
+            input.read(reinterpret_cast<char*>(&applicants), 8);
+            input.read(reinterpret_cast<char*>(&interval), 8);
+            input.read(reinterpret_cast<char*>(&rounds), 8);
+            if (!input || std::memcmp(header, magic, 4) != 0 || version != formatVersion || interval == 0) {
+                throw std::runtime_error("Error: Invalid result store header.");
+            }
+            remaining -= 32;
+            // Each round takes at least its 8-byte length, and the first keyframe one byte per applicant
+            if (rounds > remaining / 8 || (rounds > 0 && applicants > remaining)) {
+                throw std::runtime_error("Error: Result store header does not match its size.");
+            }
+
+            RoundDeltaStore store(static_cast<size_t>(interval));
+            store.applicantCount = static_cast<size_t>(applicants);
+            store.encodedRounds.resize(static_cast<size_t>(rounds));
+            std::uint64_t bitmapBytes = (applicants + 63) / 64 * sizeof(std::uint64_t);
+            for (size_t r = 0; r < store.encodedRounds.size(); ++r) {
+                EncodedRound& round = store.encodedRounds[r];
+                std::uint64_t valueBytes = 0;
+                input.read(reinterpret_cast<char*>(&valueBytes), 8);
+                round.keyframe = r % store.keyframeInterval == 0;
+                if (!input || remaining < 8 + (round.keyframe ? 0 : bitmapBytes) || valueBytes > remaining - 8 - (round.keyframe ? 0 : bitmapBytes)) {
+                    throw std::runtime_error("Error: Truncated result store.");
+                }
+                remaining -= 8 + (round.keyframe ? 0 : bitmapBytes) + valueBytes;
+
+                std::uint64_t expectedValues = applicants;
+                if (!round.keyframe) {
+                    round.changed.resize(static_cast<size_t>(bitmapBytes / sizeof(std::uint64_t)));
+                    input.read(reinterpret_cast<char*>(round.changed.data()), static_cast<std::streamsize>(bitmapBytes));
+                    expectedValues = 0;
+                    for (std::uint64_t bits : round.changed) {
+                        expectedValues += static_cast<std::uint64_t>(countSetBits(bits));
+                    }
+                }
+                round.values.resize(static_cast<size_t>(valueBytes));
+                input.read(reinterpret_cast<char*>(round.values.data()), static_cast<std::streamsize>(valueBytes));
+                if (!input) {
+                    throw std::runtime_error("Error: Truncated result store.");
+                }
+                if (countVarints(round.values) != expectedValues) {
+                    throw std::runtime_error("Error: Corrupt result store.");
+                }
+            }
+            if (remaining != 0) {
+                throw std::runtime_error("Error: Corrupt result store.");
+            }
+            if (!store.encodedRounds.empty()) {
+                store.lastRound = store.materialize(store.encodedRounds.size() - 1);
+            }
+            return store;
+        }
+
+    private:
+        // College IDs are shifted by one so noCollegeId encodes as a single zero byte
+        static void putVarint(std::vector<std::uint8_t>& out, std::int32_t collegeId) {
+            std::uint32_t value = static_cast<std::uint32_t>(collegeId + 1);
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        // Decodes one value, never reading at or past end; a 32-bit value takes at most five bytes
+        static std::int32_t getVarint(const std::uint8_t*& cursor, const std::uint8_t* end) {
+            if (cursor == end) {
+                throw std::runtime_error("Error: Corrupt result store.");
+            }
+            std::uint32_t value = *cursor++;
+            if (value >= 0x80) {
+                value &= 0x7f;
+                int shift = 7;
+                std::uint8_t byte;
+                do {
+                    if (cursor == end || shift > 28) {
+                        throw std::runtime_error("Error: Corrupt result store.");
+                    }
+                    byte = *cursor++;
+                    value |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                    shift += 7;
+                } while (byte >= 0x80);
+            }
+            return static_cast<std::int32_t>(value) - 1;
+        }
+
+        // Number of complete varints in an encoded buffer; a dangling continuation byte adds one
+        // more so the count never matches
+        static std::uint64_t countVarints(const std::vector<std::uint8_t>& values) {
+            std::uint64_t count = 0;
+            for (std::uint8_t byte : values) {
+                count += byte < 0x80;
+            }
+            return count + (!values.empty() && values.back() >= 0x80);
+        }
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Bits.h"
+#include "Parallel.h"
+
+namespace CollegeCounseling {
+    // One applicant whose college differs between two rounds
+    struct AllocationChange {
+        size_t applicantIndex;
+        std::int32_t before;
+        std::int32_t after;
+    };
+
+    // Compares two column-stored round results and reports only the applicants that moved
+    class RoundDiff {
+    public:
+        // Streams every change to the sink in applicant order. Workers scan disjoint chunks
+        // with SIMD compares; only the (few) changed indices are buffered before emitting.
+        static size_t compare(const std::vector<std::int32_t>& before, const std::vector<std::int32_t>& after,
+                              const std::function<void(const AllocationChange&)>& sink, unsigned workerCount = 0) {
+            if (before.size() != after.size()) {
+                throw std::runtime_error("Error: Round results cover different applicant sets.");
+            }
+
+            std::vector<std::vector<size_t>> changedPerWorker(
+                workerCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : workerCount);
+            runInParallel(before.size(), static_cast<unsigned>(changedPerWorker.size()),
+                          [&](size_t begin, size_t end, unsigned worker) {
+                              collectChanges(before.data(), after.data(), begin, end, changedPerWorker[worker]);
+                          });
+
+            size_t changes = 0;
+            for (const std::vector<size_t>& changed : changedPerWorker) {
+                for (size_t index : changed) {
+                    sink({ index, before[index], after[index] });
+                }
+                changes += changed.size();
+            }
+            return changes;
+        }
+
+    private:
+        // Appends the indices in [begin, end) where the two columns differ
+        static void collectChanges(const std::int32_t* before, const std::int32_t* after, size_t begin, size_t end,
+                                   std::vector<size_t>& changed) {
+            size_t i = begin;
+#if defined(__AVX2__)
+            for (; i + 8 <= end; i += 8) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(before + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(after + i));
+                unsigned mask = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))) & 0xffu;
+                while (mask != 0) {
+                    changed.push_back(i + static_cast<size_t>(countTrailingZeros(mask)));
+                    mask &= mask - 1;
+                }
+            }
+#elif defined(__SSE2__) || defined(_M_X64)
+            for (; i + 4 <= end; i += 4) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(before + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(after + i));
+                unsigned mask = ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))) & 0xfu;
+                while (mask != 0) {
+                    changed.push_back(i + static_cast<size_t>(countTrailingZeros(mask)));
+                    mask &= mask - 1;
+                }
+            }
+#endif
+            for (; i < end; ++i) {
+                if (before[i] != after[i]) {
+                    changed.push_back(i);
+                }
+            }
+        }
+    };
+}
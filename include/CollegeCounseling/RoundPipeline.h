@@ -0,0 +1,502 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AllocationJournal.h"
+#include "AllocationStrategy.h"
+#include "CollegeApplication.h"
+
+namespace CollegeCounseling {
+    // Everything needed to resume a multi-round run: which round and applicant come next,
+    // the seats taken so far in the current round and the matching built for every round.
+    // A loaded checkpoint holds only the decided part of the matching; run() fills in the rest.
+    struct RoundState {
+        std::uint32_t round = 0;
+        std::uint64_t cursor = 0;
+        std::uint32_t snapshotVersion = 0;
+        std::uint32_t roundCount = 0;
+        std::uint64_t applicantCount = 0;
+        std::vector<std::int32_t> seatLedger;
+        std::vector<std::vector<std::int32_t>> matching;
+    };
+
+    // Progress through the round in progress, as handed to CheckpointWriter: the resume point,
+    // the seat ledger and the decisions made since the previous submission, which start at
+    // applicant firstDecision of the round
+    struct RoundProgress {
+        std::uint32_t round = 0;
+        std::uint64_t cursor = 0;
+        std::uint32_t snapshotVersion = 0;
+        std::uint32_t roundCount = 0;
+        std::uint64_t applicantCount = 0;
+        std::vector<std::int32_t> seatLedger;
+        std::uint64_t firstDecision = 0;
+        std::vector<std::int32_t> decisions;
+    };
+
+    // Writes round checkpoints from a background thread so the allocation loop never waits on disk.
+    // A completed round never changes, so it is written once to its own file next to the checkpoint;
+    // the checkpoint itself holds only the round in progress. Progress submitted while an earlier
+    // one is still queued is merged into it, so the newest state is written and no decision is lost.
+    class CheckpointWriter {
+    private:
+        static constexpr char magic[4] = { 'C', 'C', 'C', 'K' };
+        static constexpr char roundMagic[4] = { 'C', 'C', 'C', 'R' };
+        static constexpr std::uint32_t formatVersion = 2;
+        // Checkpoint: magic, version, round, cursor, snapshot version, college, round and applicant counts
+        static constexpr size_t headerSize = 40;
+        // Round file: magic, version, round, snapshot version, applicant count
+        static constexpr size_t roundHeaderSize = 24;
+
+        std::string checkpointPath;
+        std::mutex writerMutex;
+        std::condition_variable workAvailable;
+        std::condition_variable workDone;
+        std::vector<std::pair<std::uint32_t, std::vector<std::int32_t>>> queuedRounds;
+        RoundProgress queued;
+        bool hasQueued = false;
+        bool writing = false;
+        bool stopping = false;
+        std::exception_ptr writeError;
+        // Round count of the newest checkpoint written, used to find the round files to discard
+        std::uint32_t writtenRoundCount = 0;
+        // Decisions of the round in progress so far; only the writer thread touches it
+        std::uint32_t prefixRound = 0;
+        std::vector<std::int32_t> roundPrefix;
+        std::thread worker;
+
+    public:
+        explicit CheckpointWriter(const std::string& path)
+            : checkpointPath(path), worker([this] { writeLoop(); }) {}
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+        // Writes the last queued state before the thread exits
+        ~CheckpointWriter() {
+            {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                stopping = true;
+            }
+            workAvailable.notify_one();
+            worker.join();
+        }
+
+        // Hands a completed round's matching to the writer thread, which writes it once
+        void submitRound(std::uint32_t round, std::vector<std::int32_t> roundMatching) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            if (writeError) {
+                std::rethrow_exception(writeError);
+            }
+            queuedRounds.emplace_back(round, std::move(roundMatching));
+            workAvailable.notify_one();
+        }
+
+        // Hands progress through the current round to the writer thread
+        void submit(RoundProgress progress) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            if (writeError) {
+                std::rethrow_exception(writeError);
+            }
+            if (hasQueued && queued.round == progress.round
+                && progress.firstDecision <= queued.firstDecision + queued.decisions.size()) {
+                queued.decisions.resize(static_cast<size_t>(progress.firstDecision - queued.firstDecision));
+                queued.decisions.insert(queued.decisions.end(), progress.decisions.begin(), progress.decisions.end());
+                progress.firstDecision = queued.firstDecision;
+                progress.decisions = std::move(queued.decisions);
+            }
+            queued = std::move(progress);
+            hasQueued = true;
+            workAvailable.notify_one();
+        }
+
+        // Blocks until every submitted state has been written
+        void flush() {
+            std::unique_lock<std::mutex> lock(writerMutex);
+            workDone.wait(lock, [this] { return (!hasQueued && queuedRounds.empty() && !writing) || writeError; });
+            if (writeError) {
+                std::rethrow_exception(writeError);
+            }
+        }
+
+        // Removes the checkpoint and its round files once a run has completed, including
+        // those left by the run it resumed
+        void discard() {
+            flush();
+            std::remove(checkpointPath.c_str());
+            for (std::uint32_t round = 0;; ++round) {
+                bool removed = std::remove(roundPath(checkpointPath, round).c_str()) == 0;
+                if (!removed && round >= writtenRoundCount) {
+                    break;
+                }
+            }
+        }
+
+        // Loads a checkpoint and the round files it covers; returns false when there is none.
+        // Every count is checked against the file size before anything is allocated from it.
+        static bool load(const std::string& path, RoundState& state) {
+            std::vector<char> contents;
+            if (!readFile(path, contents)) {
+                return false;
+            }
+            if (contents.size() < headerSize + 4 || std::memcmp(contents.data(), magic, 4) != 0) {
+                throw std::runtime_error("Error: Invalid checkpoint header.");
+            }
+            checkChecksum(contents, "Error: Corrupt checkpoint.");
+
+            size_t offset = 4;
+            std::uint32_t version = 0, collegeCount = 0;
+            read(contents, offset, &version, 4);
+            if (version != formatVersion) {
+                throw std::runtime_error("Error: Unsupported checkpoint version.");
+            }
+            read(contents, offset, &state.round, 4);
+            read(contents, offset, &state.cursor, 8);
+            read(contents, offset, &state.snapshotVersion, 4);
+            read(contents, offset, &collegeCount, 4);
+            read(contents, offset, &state.roundCount, 4);
+            read(contents, offset, &state.applicantCount, 8);
+
+            std::uint64_t bodyEntries = (contents.size() - headerSize - 4) / sizeof(std::int32_t);
+            bool inRound = state.round < state.roundCount;
+            std::uint64_t prefixEntries = inRound ? state.cursor : 0;
+            if (state.round > state.roundCount || state.cursor > state.applicantCount || collegeCount > bodyEntries
+                || prefixEntries != bodyEntries - collegeCount || (contents.size() - headerSize - 4) % sizeof(std::int32_t) != 0) {
+                throw std::runtime_error("Error: Checkpoint counts do not match its size.");
+            }
+
+            state.seatLedger.resize(collegeCount);
+            read(contents, offset, state.seatLedger.data(), collegeCount * sizeof(std::int32_t));
+            state.matching.clear();
+            for (std::uint32_t round = 0; round < state.round; ++round) {
+                state.matching.push_back(loadRound(roundPath(path, round), round, state.snapshotVersion, state.applicantCount));
+            }
+            if (inRound) {
+                state.matching.emplace_back(static_cast<size_t>(prefixEntries));
+                read(contents, offset, state.matching.back().data(), static_cast<size_t>(prefixEntries) * sizeof(std::int32_t));
+            }
+            return true;
+        }
+
+    private:
+        void writeLoop() {
+            std::unique_lock<std::mutex> lock(writerMutex);
+            while (true) {
+                workAvailable.wait(lock, [this] { return hasQueued || !queuedRounds.empty() || stopping; });
+                if (!hasQueued && queuedRounds.empty()) {
+                    return;
+                }
+                std::vector<std::pair<std::uint32_t, std::vector<std::int32_t>>> roundsToWrite;
+                roundsToWrite.swap(queuedRounds);
+                bool writeProgress = hasQueued;
+                RoundProgress progress = std::move(queued);
+                hasQueued = false;
+                writing = true;
+                lock.unlock();
+                try {
+                    // Round files go first, so a checkpoint never points past a round not yet on disk
+                    for (const auto& completed : roundsToWrite) {
+                        writeRound(completed.first, completed.second, progress.snapshotVersion);
+                    }
+                    if (writeProgress) {
+                        write(progress);
+                    }
+                } catch (...) {
+                    lock.lock();
+                    writeError = std::current_exception();
+                    writing = false;
+                    workDone.notify_all();
+                    return;
+                }
+                lock.lock();
+                if (writeProgress) {
+                    writtenRoundCount = progress.roundCount;
+                }
+                writing = false;
+                workDone.notify_all();
+            }
+        }
+
+        // Serializes the round in progress: the header, the seat ledger and the decisions so far
+        void write(const RoundProgress& progress) {
+            if (progress.round != prefixRound || progress.firstDecision > roundPrefix.size()) {
+                if (progress.firstDecision != 0) {
+                    throw std::runtime_error("Error: Checkpoint progress does not continue the previous one.");
+                }
+                prefixRound = progress.round;
+            }
+            roundPrefix.resize(static_cast<size_t>(progress.firstDecision));
+            roundPrefix.insert(roundPrefix.end(), progress.decisions.begin(), progress.decisions.end());
+            if (progress.round < progress.roundCount && roundPrefix.size() != progress.cursor) {
+                throw std::runtime_error("Error: Checkpoint progress does not cover the round so far.");
+            }
+
+            std::vector<char> buffer;
+            std::uint32_t collegeCount = static_cast<std::uint32_t>(progress.seatLedger.size());
+            put(buffer, magic, 4);
+            put(buffer, &formatVersion, 4);
+            put(buffer, &progress.round, 4);
+            put(buffer, &progress.cursor, 8);
+            put(buffer, &progress.snapshotVersion, 4);
+            put(buffer, &collegeCount, 4);
+            put(buffer, &progress.roundCount, 4);
+            put(buffer, &progress.applicantCount, 8);
+            put(buffer, progress.seatLedger.data(), collegeCount * sizeof(std::int32_t));
+            if (progress.round < progress.roundCount) {
+                put(buffer, roundPrefix.data(), roundPrefix.size() * sizeof(std::int32_t));
+            }
+            replaceFile(checkpointPath, buffer);
+        }
+
+        // Serializes one completed round to its own file
+        void writeRound(std::uint32_t round, const std::vector<std::int32_t>& roundMatching, std::uint32_t snapshotVersion) {
+            std::vector<char> buffer;
+            std::uint64_t applicantCount = roundMatching.size();
+            put(buffer, roundMagic, 4);
+            put(buffer, &formatVersion, 4);
+            put(buffer, &round, 4);
+            put(buffer, &snapshotVersion, 4);
+            put(buffer, &applicantCount, 8);
+            put(buffer, roundMatching.data(), roundMatching.size() * sizeof(std::int32_t));
+            replaceFile(roundPath(checkpointPath, round), buffer);
+        }
+
+        static std::vector<std::int32_t> loadRound(const std::string& path, std::uint32_t round,
+                                                   std::uint32_t snapshotVersion, std::uint64_t applicantCount) {
+            std::vector<char> contents;
+            if (!readFile(path, contents)) {
+                throw std::runtime_error("Error: Missing checkpoint round file " + path);
+            }
+            if (contents.size() < roundHeaderSize + 4 || std::memcmp(contents.data(), roundMagic, 4) != 0) {
+                throw std::runtime_error("Error: Invalid checkpoint round file " + path);
+            }
+            checkChecksum(contents, "Error: Corrupt checkpoint round file " + path);
+
+            size_t offset = 4;
+            std::uint32_t version = 0, storedRound = 0, storedVersion = 0;
+            std::uint64_t storedCount = 0;
+            read(contents, offset, &version, 4);
+            read(contents, offset, &storedRound, 4);
+            read(contents, offset, &storedVersion, 4);
+            read(contents, offset, &storedCount, 8);
+            if (version != formatVersion || storedRound != round || storedVersion != snapshotVersion || storedCount != applicantCount
+                || (contents.size() - roundHeaderSize - 4) % sizeof(std::int32_t) != 0
+                || (contents.size() - roundHeaderSize - 4) / sizeof(std::int32_t) != applicantCount) {
+                throw std::runtime_error("Error: Checkpoint round file does not match the checkpoint: " + path);
+            }
+            std::vector<std::int32_t> roundMatching(static_cast<size_t>(applicantCount));
+            read(contents, offset, roundMatching.data(), roundMatching.size() * sizeof(std::int32_t));
+            return roundMatching;
+        }
+
+        static std::string roundPath(const std::string& path, std::uint32_t round) {
+            return path + ".round" + std::to_string(round + 1);
+        }
+
+        static bool readFile(const std::string& path, std::vector<char>& contents) {
+            std::ifstream input(path, std::ios::binary);
+            if (!input.is_open()) {
+                return false;
+            }
+            contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+            return true;
+        }
+
+        static void read(const std::vector<char>& contents, size_t& offset, void* target, size_t length) {
+            if (offset + length > contents.size()) {
+                throw std::runtime_error("Error: Truncated checkpoint.");
+            }
+            // An empty ledger or prefix may have no storage to copy into
+            if (length != 0) {
+                std::memcpy(target, contents.data() + offset, length);
+            }
+            offset += length;
+        }
+
+        static void put(std::vector<char>& buffer, const void* data, size_t length) {
+            const char* bytes = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + length);
+        }
+
+        // The last four bytes hold the checksum of everything before them
+        static void checkChecksum(const std::vector<char>& contents, const std::string& message) {
+            std::uint32_t storedChecksum;
+            std::memcpy(&storedChecksum, contents.data() + contents.size() - 4, 4);
+            if (fnv1a(contents.data(), contents.size() - 4) != storedChecksum) {
+                throw std::runtime_error(message);
+            }
+        }
+
+        // Appends the checksum, writes to a temporary file, syncs it and renames it over the target
+        static void replaceFile(const std::string& path, std::vector<char>& buffer) {
+            std::uint32_t checksum = fnv1a(buffer.data(), buffer.size());
+            put(buffer, &checksum, 4);
+
+            std::string temporaryPath = path + ".tmp";
+            {
+                DurableFile file(temporaryPath);
+                file.truncate(0);
+                file.append(buffer.data(), buffer.size());
+                file.sync();
+            }
+#ifdef _WIN32
+            std::remove(path.c_str());
+#endif
+            if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+                throw std::runtime_error("Error: Cannot replace checkpoint file " + path);
+            }
+        }
+
+        static std::uint32_t fnv1a(const char* data, size_t length) {
+            std::uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < length; ++i) {
+                hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+            }
+            return hash;
+        }
+    };
+
+    // Runs the applicant stream through each round's strategy in turn, journaling every
+    // decision and checkpointing the round state every checkpointInterval applicants
+    class RoundPipeline {
+    private:
+        // Applicants looked up per batched strategy call
+        static constexpr size_t lookupBatchSize = 1024;
+
+        std::vector<const AllocationStrategy*> rounds;
+        int collegeCount;
+        std::uint32_t snapshotVersion;
+
+    public:
+        RoundPipeline(std::vector<const AllocationStrategy*> roundStrategies, int colleges, std::uint32_t version)
+            : rounds(std::move(roundStrategies)), collegeCount(colleges), snapshotVersion(version) {}
+
+        // Fresh state for a run over the given number of applicants
+        RoundState initialState(size_t applicantCount) const {
+            RoundState state;
+            state.snapshotVersion = snapshotVersion;
+            state.roundCount = static_cast<std::uint32_t>(rounds.size());
+            state.applicantCount = applicantCount;
+            state.seatLedger.assign(static_cast<size_t>(collegeCount), 0);
+            state.matching.assign(rounds.size(), std::vector<std::int32_t>(applicantCount, AllocationStrategy::noCollegeId));
+            return state;
+        }
+
+        // Checks that a checkpoint belongs to this pipeline, table and applicant set
+        bool canResume(const RoundState& state, size_t applicantCount) const {
+            return state.snapshotVersion == snapshotVersion
+                && state.seatLedger.size() == static_cast<size_t>(collegeCount)
+                && state.roundCount == rounds.size()
+                && state.applicantCount == applicantCount
+                && state.round <= rounds.size()
+                && state.matching.size() <= rounds.size()
+                && std::all_of(state.matching.begin(), state.matching.end(),
+                               [applicantCount](const std::vector<std::int32_t>& m) { return m.size() <= applicantCount; })
+                && state.cursor <= applicantCount;
+        }
+
+        // Continues from the given state until every round is complete. Decisions are committed
+        // to the journal before the checkpoint that covers them is submitted, so a resumed run may
+        // re-journal a few identical decisions but never loses one.
+        void run(const std::vector<CollegeApplication>& applications, RoundState& state,
+                 AllocationJournal* journal, CheckpointWriter* checkpoints, size_t checkpointInterval) const {
+            // Applicants a loaded checkpoint has no decision for start unallocated
+            state.matching.resize(rounds.size());
+            for (std::vector<std::int32_t>& roundMatching : state.matching) {
+                roundMatching.resize(applications.size(), AllocationStrategy::noCollegeId);
+            }
+            state.roundCount = static_cast<std::uint32_t>(rounds.size());
+            state.applicantCount = applications.size();
+
+            size_t sinceCheckpoint = 0;
+            while (state.round < rounds.size()) {
+                const AllocationStrategy& strategy = *rounds[state.round];
+                std::vector<std::int32_t>& roundMatching = state.matching[state.round];
+                // Decisions of this round the writer already has; a resumed round resends them all once
+                size_t submitted = 0;
+
+                std::vector<std::int32_t> chunkRanks, chunkIds;
+                size_t chunkStart = 0, chunkEnd = 0;
+                for (; state.cursor < applications.size(); ++state.cursor) {
+                    size_t position = static_cast<size_t>(state.cursor);
+                    if (position >= chunkEnd) {
+                        // Look up the next batch of applicants in one call
+                        chunkStart = position;
+                        chunkEnd = std::min(applications.size(), position + lookupBatchSize);
+                        chunkRanks.resize(chunkEnd - chunkStart);
+                        chunkIds.resize(chunkEnd - chunkStart);
+                        for (size_t i = chunkStart; i < chunkEnd; ++i) {
+                            chunkRanks[i - chunkStart] = applications[i].getApplicantRank();
+                        }
+                        strategy.allocateCollegeIds(chunkRanks.data(), chunkIds.data(), chunkRanks.size());
+                    }
+                    const CollegeApplication& application = applications[position];
+                    int collegeId = chunkIds[position - chunkStart];
+                    roundMatching[static_cast<size_t>(state.cursor)] = collegeId;
+                    if (collegeId != AllocationStrategy::noCollegeId) {
+                        ++state.seatLedger[static_cast<size_t>(collegeId)];
+                    }
+                    if (journal) {
+                        journal->append({ application.getApplicantId(), static_cast<std::int32_t>(state.round + 1), collegeId, snapshotVersion });
+                    }
+                    if (checkpoints && ++sinceCheckpoint >= checkpointInterval) {
+                        checkpoint(state, position + 1, roundMatching.data(), submitted, journal, checkpoints);
+                        sinceCheckpoint = 0;
+                    }
+                }
+
+                // Seats are counted per round, so the ledger restarts with the next round
+                if (checkpoints) {
+                    checkpoints->submitRound(state.round, roundMatching);
+                }
+                ++state.round;
+                state.cursor = 0;
+                std::fill(state.seatLedger.begin(), state.seatLedger.end(), 0);
+                if (checkpoints) {
+                    submitted = 0;
+                    checkpoint(state, 0, nullptr, submitted, journal, checkpoints);
+                    sinceCheckpoint = 0;
+                }
+            }
+            if (journal) {
+                journal->commit();
+            }
+        }
+
+    private:
+        // Submits the state resuming at applicant cursor of the current round, copying only the
+        // ledger and the decisions made since the last submission
+        static void checkpoint(const RoundState& state, std::uint64_t cursor, const std::int32_t* roundMatching, size_t& submitted,
+                               AllocationJournal* journal, CheckpointWriter* checkpoints) {
+            if (journal) {
+                journal->commit();
+            }
+            RoundProgress progress;
+            progress.round = state.round;
+            progress.cursor = cursor;
+            progress.snapshotVersion = state.snapshotVersion;
+            progress.roundCount = state.roundCount;
+            progress.applicantCount = state.applicantCount;
+            progress.seatLedger = state.seatLedger;
+            progress.firstDecision = submitted;
+            if (roundMatching) {
+                progress.decisions.assign(roundMatching + submitted, roundMatching + cursor);
+            }
+            checkpoints->submit(std::move(progress));
+            submitted = static_cast<size_t>(cursor);
+        }
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "CounselingConfig.h"
+#include "MappedFile.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Strategy of every round in a configuration. Each distinct seat-matrix file is opened and
+    // parsed once and shared by the rounds naming it; rounds without one keep their default.
+    class RoundStrategies {
+    private:
+        std::vector<std::pair<std::string, std::unique_ptr<RankIntervalStrategy>>> matrices;
+        std::vector<const AllocationStrategy*> rounds;
+        const RankIntervalStrategy* primary = nullptr;
+
+    public:
+        // defaultStrategies[i] serves round i + 1 when no seat matrix is configured for it
+        RoundStrategies(const CounselingConfig& config, const std::vector<const AllocationStrategy*>& defaultStrategies) {
+            size_t roundCount = std::max(defaultStrategies.size(), config.seatMatrices.size());
+            for (size_t round = 1; round <= roundCount; ++round) {
+                const std::string& path = config.seatMatrix(round);
+                const AllocationStrategy* strategy = round <= defaultStrategies.size() ? defaultStrategies[round - 1] : nullptr;
+                if (!path.empty()) {
+                    strategy = &matrixFor(path);
+                }
+                if (!strategy) {
+                    throw std::runtime_error("Error: No seat matrix configured for round " + std::to_string(round));
+                }
+                rounds.push_back(strategy);
+            }
+            primary = &matrixFor(config.seatMatrix(1));
+        }
+
+        const std::vector<const AllocationStrategy*>& getRounds() const {
+            return rounds;
+        }
+
+        // Round 1 seat matrix, whose college IDs and names the reports use
+        const RankIntervalStrategy& getPrimary() const {
+            return *primary;
+        }
+
+        // Largest college ID space over all loaded seat matrices
+        int getCollegeCount() const {
+            int count = 0;
+            for (const auto& matrix : matrices) {
+                count = std::max(count, matrix.second->getCollegeCount());
+            }
+            return count;
+        }
+
+        // Round 1 snapshot version, folded with the other matrices' versions when rounds have their own
+        std::uint32_t getSnapshotVersion() const {
+            std::uint32_t version = primary->getSnapshotVersion();
+            for (const auto& matrix : matrices) {
+                if (matrix.second.get() != primary) {
+                    version = (version ^ matrix.second->getSnapshotVersion()) * 16777619u;
+                }
+            }
+            return version;
+        }
+
+    private:
+        const RankIntervalStrategy& matrixFor(const std::string& path) {
+            for (const auto& matrix : matrices) {
+                if (matrix.first == path) {
+                    return *matrix.second;
+                }
+            }
+            matrices.emplace_back(path, std::make_unique<RankIntervalStrategy>(MappedFile::open(path)));
+            return *matrices.back().second;
+        }
+    };
+}
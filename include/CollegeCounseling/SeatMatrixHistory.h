@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "CollegeNamePool.h"
+#include "CounselingConfig.h"
+#include "MappedFile.h"
+#include "RankIntervalStrategy.h"
+#include "SeatMatrixSnapshot.h"
+
+namespace CollegeCounseling {
+    // Seat state of every round as structurally shared snapshots. Each round is recorded as the
+    // previous round plus its differences, so the history costs about one table plus the changed
+    // paths, and any past round stays available for audits and what-if runs.
+    class SeatMatrixHistory {
+    private:
+        std::map<int, SeatMatrixSnapshot> rounds;
+
+    public:
+        // Loads every configured round's seat matrix in turn, keeping only one parsed file at a time
+        static SeatMatrixHistory fromConfig(const CounselingConfig& config) {
+            SeatMatrixHistory history;
+            auto names = std::make_shared<CollegeNamePool>();
+            for (size_t round = 1; round <= config.seatMatrices.size(); ++round) {
+                const std::string& path = config.seatMatrix(round);
+                if (path.empty()) {
+                    continue;
+                }
+                RankIntervalStrategy table(MappedFile::open(path), names);
+                history.record(static_cast<int>(round), history.rounds.empty() ? SeatMatrixSnapshot(table)
+                                                                                : history.rounds.rbegin()->second.updatedTo(table));
+            }
+            return history;
+        }
+
+        void record(int round, SeatMatrixSnapshot snapshot) {
+            rounds.erase(round);
+            rounds.emplace(round, std::move(snapshot));
+        }
+
+        const SeatMatrixSnapshot& at(int round) const {
+            auto found = rounds.find(round);
+            if (found == rounds.end()) {
+                throw std::runtime_error("Error: No seat matrix recorded for round " + std::to_string(round));
+            }
+            return found->second;
+        }
+
+        const std::map<int, SeatMatrixSnapshot>& getRounds() const {
+            return rounds;
+        }
+
+        // Node bytes held by all rounds together, shared nodes counted once
+        size_t getSharedBytes() const {
+            std::unordered_set<const void*> seen;
+            size_t bytes = 0;
+            for (const auto& round : rounds) {
+                bytes += round.second.addUniqueNodeBytes(seen);
+            }
+            return bytes;
+        }
+
+        // Node bytes the rounds would hold as independent copies
+        size_t getUnsharedBytes() const {
+            size_t bytes = 0;
+            for (const auto& round : rounds) {
+                bytes += round.second.getNodeBytes();
+            }
+            return bytes;
+        }
+    };
+}
@@ -0,0 +1,510 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "AllocationStrategy.h"
+#include "CollegeNamePool.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Immutable, structurally shared seat matrix. Intervals live in a persistent B+-tree ordered
+    // by (rankStart, ID) and rows in a persistent radix trie by ID, both built from immutable
+    // nodes. An edit returns a new snapshot that copies only the O(log n) nodes on its path and
+    // shares every other node with its source, so keeping every round's seat state costs one
+    // full table plus O(log n) nodes per edit. A snapshot is an AllocationStrategy and copying
+    // one is two pointer copies.
+    // IDs keep RankIntervalStrategy's first-match order: a new interval gets the next ID, and a
+    // removed one keeps its ID and name with an empty range.
+    class SeatMatrixSnapshot : public AllocationStrategy {
+    private:
+        static constexpr size_t nodeCapacity = 32;
+        static constexpr size_t minNodeFill = nodeCapacity / 4;
+        static constexpr int rowBits = 5;
+        static constexpr size_t rowFanout = size_t(1) << rowBits;
+
+        // Interval entry, ordered by (rankStart, id)
+        struct Entry {
+            int rankStart;
+            int rankEnd;
+            std::int32_t id;
+
+            bool operator<(const Entry& other) const {
+                return std::tie(rankStart, id) < std::tie(other.rankStart, other.id);
+            }
+        };
+
+        // Immutable B+-tree node. Leaves hold entries; inner nodes hold children and the first
+        // entry of each. Every node records its largest rankEnd and smallest ID, so a lookup
+        // skips subtrees that cannot cover the rank or cannot beat the match found so far.
+        struct TreeNode {
+            std::vector<Entry> entries;
+            std::vector<std::shared_ptr<const TreeNode>> children;
+            int maxRankEnd = std::numeric_limits<int>::min();
+            std::int32_t minId = std::numeric_limits<std::int32_t>::max();
+
+            bool isLeaf() const {
+                return children.empty();
+            }
+
+            size_t size() const {
+                return isLeaf() ? entries.size() : children.size();
+            }
+        };
+
+        struct Row {
+            int rankStart;
+            int rankEnd;
+            const std::string* college;
+        };
+
+        // Immutable radix-trie node of the row table: rowFanout rows at the bottom level,
+        // rowFanout children above it
+        struct RowNode {
+            std::vector<Row> rows;
+            std::vector<std::shared_ptr<const RowNode>> children;
+        };
+
+        std::shared_ptr<CollegeNamePool> namePool;
+        std::shared_ptr<const TreeNode> tree;
+        std::shared_ptr<const RowNode> rows;
+        // Trie levels above the bottom one
+        int rowLevels = 0;
+        size_t rowCount = 0;
+        size_t intervalCount = 0;
+
+    public:
+        // Empty table with a private name pool
+        SeatMatrixSnapshot() : namePool(std::make_shared<CollegeNamePool>()), tree(std::make_shared<TreeNode>()) {}
+
+        // Copies a loaded seat matrix, keeping its IDs and sharing its name pool
+        explicit SeatMatrixSnapshot(const RankIntervalStrategy& table) : namePool(table.getNamePool()) {
+            std::vector<Row> tableRows(static_cast<size_t>(table.getCollegeCount()));
+            std::vector<Entry> entries;
+            for (size_t id = 0; id < tableRows.size(); ++id) {
+                std::pair<int, int> interval = table.getRankInterval(static_cast<int>(id));
+                tableRows[id] = { interval.first, interval.second, &table.getCollegeName(static_cast<int>(id)) };
+                if (interval.first <= interval.second) {
+                    entries.push_back({ interval.first, interval.second, static_cast<std::int32_t>(id) });
+                }
+            }
+            std::sort(entries.begin(), entries.end());
+            tree = buildTree(entries);
+            intervalCount = entries.size();
+            buildRows(tableRows, *this);
+        }
+
+        std::string allocateCollege(int userRank) const override {
+            int collegeId = findCollegeId(*this, userRank);
+            if (collegeId == noCollegeId) {
+                return "No college allocated for your rank.";
+            }
+            return *rowAt(*this, static_cast<size_t>(collegeId)).college;
+        }
+
+        int allocateCollegeId(int userRank) const override {
+            return findCollegeId(*this, userRank);
+        }
+
+        // Snapshot with a college interval added under the next ID (getCollegeCount())
+        SeatMatrixSnapshot withInterval(int rankStart, int rankEnd, const std::string& college) const {
+            checkRange(rankStart, rankEnd);
+            const std::string* name = &namePool->intern(college);
+            SeatMatrixSnapshot next(*this);
+            appendRow(next, { 0, -1, name });
+            replaceRow(next, next.rowCount - 1, { rankStart, rankEnd, name });
+            return next;
+        }
+
+        // Snapshot with a college's interval withdrawn; its ID and name stay with an empty range
+        SeatMatrixSnapshot withoutInterval(int collegeId) const {
+            SeatMatrixSnapshot next(*this);
+            replaceRow(next, static_cast<size_t>(collegeId), { 0, -1, checkedRow(*this, collegeId).college });
+            return next;
+        }
+
+        // Snapshot with a college's interval moved to [rankStart, rankEnd]
+        SeatMatrixSnapshot withRankInterval(int collegeId, int rankStart, int rankEnd) const {
+            checkRange(rankStart, rankEnd);
+            SeatMatrixSnapshot next(*this);
+            replaceRow(next, static_cast<size_t>(collegeId), { rankStart, rankEnd, checkedRow(*this, collegeId).college });
+            return next;
+        }
+
+        // Snapshot holding the given table, editing only the rows that differ from this one:
+        // changed ranges or names are replaced, extra rows appended and missing rows withdrawn.
+        // Consecutive rounds of a seat matrix mostly agree, so the result shares most nodes.
+        SeatMatrixSnapshot updatedTo(const RankIntervalStrategy& table) const {
+            SeatMatrixSnapshot next(*this);
+            size_t tableCount = static_cast<size_t>(table.getCollegeCount());
+            for (size_t id = 0; id < std::max(tableCount, rowCount); ++id) {
+                Row wanted{ 0, -1, nullptr };
+                if (id < tableCount) {
+                    std::pair<int, int> interval = table.getRankInterval(static_cast<int>(id));
+                    wanted = { interval.first, interval.second, &table.getCollegeName(static_cast<int>(id)) };
+                }
+                if (id >= rowCount) {
+                    appendRow(next, { 0, -1, &namePool->intern(*wanted.college) });
+                }
+                const Row& row = rowAt(next, id);
+                if (!wanted.college) {
+                    wanted.college = row.college;
+                } else if (wanted.college != row.college && *wanted.college != *row.college) {
+                    wanted.college = &namePool->intern(*wanted.college);
+                } else {
+                    wanted.college = row.college;
+                }
+                bool live = row.rankStart <= row.rankEnd;
+                bool wantedLive = wanted.rankStart <= wanted.rankEnd;
+                if (wanted.college != row.college || live != wantedLive
+                    || (wantedLive && (wanted.rankStart != row.rankStart || wanted.rankEnd != row.rankEnd))) {
+                    replaceRow(next, id, wanted);
+                }
+            }
+            return next;
+        }
+
+        // Number of IDs ever assigned, removed ones included
+        int getCollegeCount() const {
+            return static_cast<int>(rowCount);
+        }
+
+        // Number of live (non-empty) intervals
+        size_t getIntervalCount() const {
+            return intervalCount;
+        }
+
+        const std::string& getCollegeName(int collegeId) const {
+            return *checkedRow(*this, collegeId).college;
+        }
+
+        // Rank interval [start, end] of a college; start > end once removed
+        std::pair<int, int> getRankInterval(int collegeId) const {
+            const Row& row = checkedRow(*this, collegeId);
+            return { row.rankStart, row.rankEnd };
+        }
+
+        // Bytes of the nodes reachable from this snapshot, excluding the name pool
+        size_t getNodeBytes() const {
+            std::unordered_set<const void*> seen;
+            return addUniqueNodeBytes(seen);
+        }
+
+        // Bytes of the reachable nodes not already in seen, which receives them; summing this over
+        // several snapshots with one set gives the memory they really hold together
+        size_t addUniqueNodeBytes(std::unordered_set<const void*>& seen) const {
+            return treeBytes(tree.get(), seen) + rowBytes(rows.get(), seen);
+        }
+
+    private:
+        static void checkRange(int rankStart, int rankEnd) {
+            if (rankStart > rankEnd) {
+                throw std::runtime_error("Error: Invalid rank range " + std::to_string(rankStart) + "-" + std::to_string(rankEnd));
+            }
+        }
+
+        // Replaces a row, moving its tree entry when the range changes
+        static void replaceRow(SeatMatrixSnapshot& snapshot, size_t id, const Row& row) {
+            const Row& old = checkedRow(snapshot, static_cast<int>(id));
+            std::int32_t collegeId = static_cast<std::int32_t>(id);
+            bool live = old.rankStart <= old.rankEnd;
+            bool nowLive = row.rankStart <= row.rankEnd;
+            if (live != nowLive || (live && (old.rankStart != row.rankStart || old.rankEnd != row.rankEnd))) {
+                if (live) {
+                    snapshot.tree = eraseEntry(snapshot.tree, { old.rankStart, old.rankEnd, collegeId });
+                    --snapshot.intervalCount;
+                }
+                if (nowLive) {
+                    snapshot.tree = insertEntry(snapshot.tree, { row.rankStart, row.rankEnd, collegeId });
+                    ++snapshot.intervalCount;
+                }
+            }
+            setRow(snapshot, id, row);
+        }
+
+        static size_t treeBytes(const TreeNode* node, std::unordered_set<const void*>& seen) {
+            if (!node || !seen.insert(node).second) {
+                return 0;
+            }
+            size_t bytes = sizeof(TreeNode) + node->entries.capacity() * sizeof(Entry)
+                         + node->children.capacity() * sizeof(std::shared_ptr<const TreeNode>);
+            for (const auto& child : node->children) {
+                bytes += treeBytes(child.get(), seen);
+            }
+            return bytes;
+        }
+
+        static size_t rowBytes(const RowNode* node, std::unordered_set<const void*>& seen) {
+            if (!node || !seen.insert(node).second) {
+                return 0;
+            }
+            size_t bytes = sizeof(RowNode) + node->rows.capacity() * sizeof(Row)
+                         + node->children.capacity() * sizeof(std::shared_ptr<const RowNode>);
+            for (const auto& child : node->children) {
+                bytes += rowBytes(child.get(), seen);
+            }
+            return bytes;
+        }
+
+        // Lowest ID whose interval covers the rank
+        static int findCollegeId(const SeatMatrixSnapshot& snapshot, int userRank) {
+            std::int32_t best = noCollegeId;
+            findCovering(*snapshot.tree, userRank, best);
+            return best;
+        }
+
+        static void findCovering(const TreeNode& node, int userRank, std::int32_t& best) {
+            if (node.maxRankEnd < userRank || (best != noCollegeId && node.minId >= best)) {
+                return;
+            }
+            for (size_t i = 0; i < node.entries.size() && node.entries[i].rankStart <= userRank; ++i) {
+                if (!node.isLeaf()) {
+                    findCovering(*node.children[i], userRank, best);
+                } else if (node.entries[i].rankEnd >= userRank && (best == noCollegeId || node.entries[i].id < best)) {
+                    best = node.entries[i].id;
+                }
+            }
+        }
+
+        // Recomputes the summaries (and an inner node's child keys) after its contents changed
+        static void refresh(TreeNode& node) {
+            node.maxRankEnd = std::numeric_limits<int>::min();
+            node.minId = std::numeric_limits<std::int32_t>::max();
+            if (node.isLeaf()) {
+                for (const Entry& entry : node.entries) {
+                    node.maxRankEnd = std::max(node.maxRankEnd, entry.rankEnd);
+                    node.minId = std::min(node.minId, entry.id);
+                }
+                return;
+            }
+            node.entries.resize(node.children.size());
+            for (size_t i = 0; i < node.children.size(); ++i) {
+                node.entries[i] = node.children[i]->entries.front();
+                node.maxRankEnd = std::max(node.maxRankEnd, node.children[i]->maxRankEnd);
+                node.minId = std::min(node.minId, node.children[i]->minId);
+            }
+        }
+
+        // Bottom-up build over sorted entries. Nodes are filled to three quarters, leaving room
+        // for later inserts, and sized evenly so none starts below minNodeFill.
+        static std::shared_ptr<const TreeNode> buildTree(const std::vector<Entry>& entries) {
+            std::vector<std::shared_ptr<const TreeNode>> level;
+            std::vector<size_t> bounds = evenChunks(entries.size());
+            for (size_t c = 0; c + 1 < bounds.size(); ++c) {
+                auto leaf = std::make_shared<TreeNode>();
+                leaf->entries.assign(entries.begin() + bounds[c], entries.begin() + bounds[c + 1]);
+                refresh(*leaf);
+                level.push_back(std::move(leaf));
+            }
+            if (level.empty()) {
+                return std::make_shared<TreeNode>();
+            }
+            while (level.size() > 1) {
+                std::vector<std::shared_ptr<const TreeNode>> parents;
+                bounds = evenChunks(level.size());
+                for (size_t c = 0; c + 1 < bounds.size(); ++c) {
+                    auto inner = std::make_shared<TreeNode>();
+                    inner->children.assign(level.begin() + bounds[c], level.begin() + bounds[c + 1]);
+                    refresh(*inner);
+                    parents.push_back(std::move(inner));
+                }
+                level.swap(parents);
+            }
+            return level.front();
+        }
+
+        // Boundaries splitting count items into equal chunks of at most three quarters of a node
+        static std::vector<size_t> evenChunks(size_t count) {
+            const size_t fill = nodeCapacity * 3 / 4;
+            size_t chunks = (count + fill - 1) / fill;
+            std::vector<size_t> bounds;
+            for (size_t c = 0; c <= chunks; ++c) {
+                bounds.push_back(count * c / chunks);
+            }
+            return bounds;
+        }
+
+        // Child of an inner node whose key range holds the entry
+        static size_t childFor(const TreeNode& node, const Entry& entry) {
+            size_t position = static_cast<size_t>(std::upper_bound(node.entries.begin(), node.entries.end(), entry) - node.entries.begin());
+            return position == 0 ? 0 : position - 1;
+        }
+
+        // Splits an overfull node into two halves; the first stays in place
+        static std::shared_ptr<TreeNode> splitOff(TreeNode& node) {
+            auto sibling = std::make_shared<TreeNode>();
+            if (node.isLeaf()) {
+                size_t half = node.entries.size() / 2;
+                sibling->entries.assign(node.entries.begin() + half, node.entries.end());
+                node.entries.resize(half);
+            } else {
+                size_t half = node.children.size() / 2;
+                sibling->children.assign(node.children.begin() + half, node.children.end());
+                node.children.resize(half);
+            }
+            refresh(node);
+            refresh(*sibling);
+            return sibling;
+        }
+
+        // Copies the path to the entry's leaf, inserting it there; returns the new node and, when it
+        // had to split, its new right sibling
+        static std::pair<std::shared_ptr<const TreeNode>, std::shared_ptr<const TreeNode>> insertInto(const TreeNode& node, const Entry& entry) {
+            auto copy = std::make_shared<TreeNode>(node);
+            if (copy->isLeaf()) {
+                copy->entries.insert(std::upper_bound(copy->entries.begin(), copy->entries.end(), entry), entry);
+            } else {
+                size_t child = childFor(*copy, entry);
+                auto replaced = insertInto(*copy->children[child], entry);
+                copy->children[child] = replaced.first;
+                if (replaced.second) {
+                    copy->children.insert(copy->children.begin() + child + 1, replaced.second);
+                }
+            }
+            std::shared_ptr<TreeNode> sibling;
+            if (copy->size() > nodeCapacity) {
+                sibling = splitOff(*copy);
+            } else {
+                refresh(*copy);
+            }
+            return { copy, sibling };
+        }
+
+        static std::shared_ptr<const TreeNode> insertEntry(const std::shared_ptr<const TreeNode>& root, const Entry& entry) {
+            auto replaced = insertInto(*root, entry);
+            if (!replaced.second) {
+                return replaced.first;
+            }
+            auto grown = std::make_shared<TreeNode>();
+            grown->children = { replaced.first, replaced.second };
+            refresh(*grown);
+            return grown;
+        }
+
+        // Copies the path to the entry's leaf, removing it there. Children left below minNodeFill
+        // are merged with a neighbour, and the merge is split again if it overflows.
+        static std::shared_ptr<const TreeNode> eraseFrom(const TreeNode& node, const Entry& entry) {
+            auto copy = std::make_shared<TreeNode>(node);
+            if (copy->isLeaf()) {
+                auto found = std::lower_bound(copy->entries.begin(), copy->entries.end(), entry);
+                if (found == copy->entries.end() || found->id != entry.id || found->rankStart != entry.rankStart) {
+                    throw std::runtime_error("Error: Interval index out of sync for college " + std::to_string(entry.id));
+                }
+                copy->entries.erase(found);
+                refresh(*copy);
+                return copy;
+            }
+
+            size_t child = childFor(*copy, entry);
+            std::shared_ptr<const TreeNode> shrunk = eraseFrom(*copy->children[child], entry);
+            copy->children[child] = shrunk;
+            if (shrunk->size() < minNodeFill && copy->children.size() > 1) {
+                size_t left = child + 1 < copy->children.size() ? child : child - 1;
+                auto merged = std::make_shared<TreeNode>(*copy->children[left]);
+                const TreeNode& right = *copy->children[left + 1];
+                merged->entries.insert(merged->entries.end(), right.entries.begin(), right.entries.end());
+                merged->children.insert(merged->children.end(), right.children.begin(), right.children.end());
+                copy->children.erase(copy->children.begin() + left + 1);
+                if (merged->size() > nodeCapacity) {
+                    copy->children.insert(copy->children.begin() + left + 1, splitOff(*merged));
+                } else {
+                    refresh(*merged);
+                }
+                copy->children[left] = merged;
+            }
+            // An emptied leaf under a single-child parent is dropped here
+            if (copy->children.size() == 1 && copy->children.front()->size() == 0) {
+                copy->children.clear();
+                copy->entries.clear();
+            }
+            refresh(*copy);
+            return copy;
+        }
+
+        static std::shared_ptr<const TreeNode> eraseEntry(const std::shared_ptr<const TreeNode>& root, const Entry& entry) {
+            std::shared_ptr<const TreeNode> shrunk = eraseFrom(*root, entry);
+            while (!shrunk->isLeaf() && shrunk->children.size() == 1) {
+                shrunk = shrunk->children.front();
+            }
+            return shrunk;
+        }
+
+        static const Row& rowAt(const SeatMatrixSnapshot& snapshot, size_t id) {
+            const RowNode* node = snapshot.rows.get();
+            for (int level = snapshot.rowLevels; level > 0; --level) {
+                node = node->children[(id >> (level * rowBits)) & (rowFanout - 1)].get();
+            }
+            return node->rows[id & (rowFanout - 1)];
+        }
+
+        static const Row& checkedRow(const SeatMatrixSnapshot& snapshot, int collegeId) {
+            if (collegeId < 0 || static_cast<size_t>(collegeId) >= snapshot.rowCount) {
+                throw std::runtime_error("Error: Unknown college ID " + std::to_string(collegeId));
+            }
+            return rowAt(snapshot, static_cast<size_t>(collegeId));
+        }
+
+        // Copies the trie path to an ID, creating missing nodes, and stores the row there
+        static std::shared_ptr<const RowNode> storeRow(const RowNode* node, int level, size_t id, const Row& row) {
+            auto copy = node ? std::make_shared<RowNode>(*node) : std::make_shared<RowNode>();
+            size_t slot = (id >> (level * rowBits)) & (rowFanout - 1);
+            if (level == 0) {
+                if (copy->rows.size() <= slot) {
+                    copy->rows.resize(slot + 1);
+                }
+                copy->rows[slot] = row;
+            } else {
+                if (copy->children.size() <= slot) {
+                    copy->children.resize(slot + 1);
+                }
+                copy->children[slot] = storeRow(copy->children[slot].get(), level - 1, id, row);
+            }
+            return copy;
+        }
+
+        static void setRow(SeatMatrixSnapshot& snapshot, size_t id, const Row& row) {
+            snapshot.rows = storeRow(snapshot.rows.get(), snapshot.rowLevels, id, row);
+        }
+
+        static void appendRow(SeatMatrixSnapshot& snapshot, const Row& row) {
+            if (snapshot.rowCount == rowFanout << (snapshot.rowLevels * rowBits)) {
+                auto grown = std::make_shared<RowNode>();
+                grown->children.push_back(snapshot.rows);
+                snapshot.rows = grown;
+                ++snapshot.rowLevels;
+            }
+            setRow(snapshot, snapshot.rowCount++, row);
+        }
+
+        // Bottom-up build of the row trie
+        static void buildRows(const std::vector<Row>& rows, SeatMatrixSnapshot& snapshot) {
+            std::vector<std::shared_ptr<const RowNode>> level;
+            for (size_t first = 0; first < rows.size(); first += rowFanout) {
+                auto leaf = std::make_shared<RowNode>();
+                leaf->rows.assign(rows.begin() + first, rows.begin() + std::min(rows.size(), first + rowFanout));
+                level.push_back(std::move(leaf));
+            }
+            snapshot.rowLevels = 0;
+            while (level.size() > 1) {
+                std::vector<std::shared_ptr<const RowNode>> parents;
+                for (size_t first = 0; first < level.size(); first += rowFanout) {
+                    auto inner = std::make_shared<RowNode>();
+                    inner->children.assign(level.begin() + first, level.begin() + std::min(level.size(), first + rowFanout));
+                    parents.push_back(std::move(inner));
+                }
+                level.swap(parents);
+                ++snapshot.rowLevels;
+            }
+            snapshot.rows = level.empty() ? std::make_shared<RowNode>() : level.front();
+            snapshot.rowCount = rows.size();
+        }
+    };
+}
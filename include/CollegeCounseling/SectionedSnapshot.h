@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "MappedFile.h"
+
+namespace CollegeCounseling {
+    // Sectioned seat-matrix snapshot, for tables too large to load whole at startup:
+    // a header, sectionCount section entries, then the sections themselves. Each section is a
+    // run of consecutive college IDs stored as ordinary "start-end: name" lines; its entry
+    // records the rank range its intervals span and where its bytes are, so a reader parses
+    // only the sections a queried rank falls in. Integers are in host byte order.
+    struct SectionedSnapshotHeader {
+        char magic[4];
+        std::uint32_t formatVersion;
+        // Snapshot version of the source table, so journals match the plain file's
+        std::uint32_t snapshotVersion;
+        std::uint32_t collegeCount;
+        std::uint32_t sectionCount;
+        std::uint32_t reserved;
+    };
+
+    // Sparse index entry: ranks [rankMin, rankMax] are covered only by IDs
+    // [firstId, firstId + rowCount), whose lines sit at [offset, offset + length) in the file
+    struct SnapshotSection {
+        std::int32_t rankMin;
+        std::int32_t rankMax;
+        std::int32_t firstId;
+        std::int32_t rowCount;
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+
+    static_assert(sizeof(SectionedSnapshotHeader) == 24, "SectionedSnapshotHeader must stay 24 bytes on disk");
+    static_assert(sizeof(SnapshotSection) == 32, "SnapshotSection must stay 32 bytes on disk");
+
+    constexpr char sectionedSnapshotMagic[4] = { 'C', 'C', 'S', 'S' };
+    constexpr std::uint32_t sectionedSnapshotFormat = 1;
+
+    inline bool isSectionedSnapshot(const MappedFile& file) {
+        return file.size() >= sizeof(SectionedSnapshotHeader) && std::memcmp(file.data(), sectionedSnapshotMagic, 4) == 0;
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "CollegeApplication.h"
+#include "Matching.h"
+#include "Parallel.h"
+#include "PhiloxRng.h"
+#include "RankIntervalStrategy.h"
+
+namespace CollegeCounseling {
+    // Knobs for randomized what-if scenarios
+    struct ScenarioSettings {
+        double preferenceSwapRate = 0.1;
+        double seatScaleMin = 0.9;
+        double seatScaleMax = 1.1;
+        double withdrawalRate = 0.05;
+        int preferenceWindow = 3;
+        std::uint64_t tieBreakSeed = 0;
+    };
+
+    // Outcome distribution over all scenarios, per college and overall
+    struct SimulationSummary {
+        size_t scenarioCount = 0;
+        std::vector<double> meanSeatsFilled;
+        std::vector<std::vector<int>> closingRanks;
+        std::vector<std::int64_t> unallocated;
+
+        // Closing rank of a college at the given quantile (0..1) across scenarios
+        int closingRankQuantile(int collegeId, double quantile) const {
+            std::vector<int> ranks = closingRanks.at(collegeId);
+            if (ranks.empty()) {
+                return 0;
+            }
+            size_t position = static_cast<size_t>(quantile * (ranks.size() - 1) + 0.5);
+            std::nth_element(ranks.begin(), ranks.begin() + position, ranks.end());
+            return ranks[position];
+        }
+    };
+
+    // Monte Carlo engine running independent randomized allocation scenarios in parallel.
+    // Scenario s always draws from Philox stream s of the seed, so the outcome does not depend
+    // on the worker count. The RankIntervalStrategy index and applicant set are shared read-only.
+    class WhatIfSimulator {
+    private:
+        const RankIntervalStrategy& index;
+        const std::vector<CollegeApplication>& applications;
+        ScenarioSettings settings;
+        PreferenceTable basePreferences;
+        std::vector<std::uint32_t> meritOrder;
+
+    public:
+        WhatIfSimulator(const RankIntervalStrategy& rankIndex, const std::vector<CollegeApplication>& applicantSet,
+                        const ScenarioSettings& scenarioSettings = ScenarioSettings())
+            : index(rankIndex), applications(applicantSet), settings(scenarioSettings),
+              basePreferences(PreferenceTable::fromRankIntervals(rankIndex, applicantSet, scenarioSettings.preferenceWindow)) {
+            meritOrder = LotteryTieBreaker(settings.tieBreakSeed).meritOrder(applications);
+        }
+
+        SimulationSummary run(size_t scenarioCount, std::uint64_t seed, unsigned workerCount = 0) const {
+            size_t colleges = static_cast<size_t>(index.getCollegeCount());
+            std::vector<std::vector<std::int32_t>> fills(scenarioCount);
+            SimulationSummary summary;
+            summary.scenarioCount = scenarioCount;
+            summary.closingRanks.assign(colleges, std::vector<int>(scenarioCount, 0));
+            summary.unallocated.assign(scenarioCount, 0);
+
+            runInParallel(scenarioCount, workerCount, [&](size_t begin, size_t end, unsigned) {
+                for (size_t scenario = begin; scenario < end; ++scenario) {
+                    std::vector<std::int32_t> result = runScenario(PhiloxRng(seed, scenario));
+                    std::vector<std::int32_t>& fill = fills[scenario];
+                    fill.assign(colleges, 0);
+                    for (size_t i = 0; i < result.size(); ++i) {
+                        if (result[i] == AllocationStrategy::noCollegeId) {
+                            ++summary.unallocated[scenario];
+                            continue;
+                        }
+                        ++fill[result[i]];
+                        int& closing = summary.closingRanks[result[i]][scenario];
+                        closing = std::max(closing, applications[i].getApplicantRank());
+                    }
+                }
+            });
+
+            summary.meanSeatsFilled.assign(colleges, 0.0);
+            for (const std::vector<std::int32_t>& fill : fills) {
+                for (size_t c = 0; c < colleges; ++c) {
+                    summary.meanSeatsFilled[c] += static_cast<double>(fill[c]) / std::max<size_t>(scenarioCount, 1);
+                }
+            }
+            return summary;
+        }
+
+    private:
+        // One scenario: scaled seats, withdrawals, perturbed preferences, then allocation.
+        // Withdrawn applicants keep an empty list so they take no seat.
+        std::vector<std::int32_t> runScenario(PhiloxRng rng) const {
+            double seatScale = settings.seatScaleMin + (settings.seatScaleMax - settings.seatScaleMin) * rng.nextUnit();
+            std::vector<int> seats(static_cast<size_t>(index.getCollegeCount()));
+            for (size_t c = 0; c < seats.size(); ++c) {
+                seats[c] = static_cast<int>(index.getCollegeCapacity(static_cast<int>(c)) * seatScale + 0.5);
+            }
+
+            PreferenceTable preferences;
+            preferences.offsets.reserve(basePreferences.offsets.size());
+            preferences.colleges.reserve(basePreferences.colleges.size());
+            std::vector<std::int32_t> choices;
+            for (size_t applicant = 0; applicant < basePreferences.size(); ++applicant) {
+                const std::int32_t* first = basePreferences.colleges.data() + basePreferences.offsets[applicant];
+                const std::int32_t* last = basePreferences.colleges.data() + basePreferences.offsets[applicant + 1];
+                if (rng.nextUnit() < settings.withdrawalRate) {
+                    preferences.add(first, 0);
+                    continue;
+                }
+                choices.assign(first, last);
+                for (size_t k = 1; k < choices.size(); ++k) {
+                    if (rng.nextUnit() < settings.preferenceSwapRate) {
+                        std::swap(choices[k - 1], choices[k]);
+                    }
+                }
+                preferences.add(choices.data(), choices.size());
+            }
+            return SerialDictatorship::allocate(meritOrder, preferences, std::move(seats));
+        }
+    };
+}
@@ -0,0 +1,84 @@
+#ifndef COLLEGE_COUNSELING_H
+#define COLLEGE_COUNSELING_H
+
+/*
+ * C ABI over the seat-matrix index for callers outside C++. Functions never throw; they
+ * return a status code and leave a message for cc_last_error(). Batch calls read and write
+ * caller-owned buffers directly, so no allocation or copy happens per call.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(COLLEGE_COUNSELING_C_BUILD)
+#define CC_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define CC_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define CC_API __attribute__((visibility("default")))
+#else
+#define CC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returned for ranks no college covers and names not in the matrix */
+#define CC_NO_COLLEGE (-1)
+
+typedef enum cc_status {
+    CC_OK = 0,
+    CC_INVALID_ARGUMENT = 1,
+    /* Also returned by queries on a sectioned snapshot when a section they parse is corrupt */
+    CC_LOAD_FAILED = 2,
+    CC_BUFFER_TOO_SMALL = 3
+} cc_status;
+
+/* Opaque handle to a loaded seat matrix; immutable, so it may be shared across threads */
+typedef struct cc_seat_matrix cc_seat_matrix;
+
+/* Loads a seat matrix file into *matrix */
+CC_API cc_status cc_seat_matrix_open(const char* path, cc_seat_matrix** matrix);
+
+CC_API void cc_seat_matrix_close(cc_seat_matrix* matrix);
+
+/* Message for the last failed call on this thread; empty when there is none */
+CC_API const char* cc_last_error(void);
+
+CC_API int32_t cc_college_count(const cc_seat_matrix* matrix);
+
+CC_API uint32_t cc_snapshot_version(const cc_seat_matrix* matrix);
+
+/* Writes the college ID (or CC_NO_COLLEGE) for each of count ranks into college_ids */
+CC_API cc_status cc_allocate_ids(const cc_seat_matrix* matrix, const int32_t* ranks, int32_t* college_ids, size_t count);
+
+/* College ID for a name of the given length, or CC_NO_COLLEGE (with a message if lookup failed) */
+CC_API int32_t cc_find_college(const cc_seat_matrix* matrix, const char* name, size_t length);
+
+/*
+ * Copies a college name (without terminator) into buffer. *length always receives the full
+ * name length, so a call with capacity 0 sizes the buffer.
+ */
+CC_API cc_status cc_college_name(const cc_seat_matrix* matrix, int32_t college_id, char* buffer, size_t capacity,
+                                 size_t* length);
+
+/*
+ * Writes the IDs of the colleges whose intervals overlap ranks [first_rank, last_rank], in
+ * interval start order. *count always receives the full number, so a call with capacity 0
+ * sizes the buffer.
+ */
+CC_API cc_status cc_band(const cc_seat_matrix* matrix, int32_t first_rank, int32_t last_rank, int32_t* college_ids, size_t capacity,
+                         size_t* count);
+
+/*
+ * Borrowed view of the elementary-segment index: segment i covers ranks
+ * [starts[i], starts[i + 1]) and maps to ids[i]. Valid until the matrix is closed.
+ */
+CC_API cc_status cc_segments(const cc_seat_matrix* matrix, const int32_t** starts, const int32_t** ids, size_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
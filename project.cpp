@@ -2,149 +2,51 @@
 #include <fstream>
 #include <string>
 #include <vector>
-#include <functional>
 #include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
 
-namespace CollegeCounseling {
-    // Abstract base class for allocation strategies
-    class AllocationStrategy {
-    public:
-        virtual std::string allocateCollege(int userRank) const = 0;
-    };
-
-    // Derived class implementing an allocation strategy based on rank intervals
-    class RankIntervalStrategy : public AllocationStrategy {
-    private:
-        // Structure to hold data about colleges and rank intervals
-        struct CollegeData {
-            int rankStart;
-            int rankEnd;
-            std::string college;
-        };
-
-        // Vector to store college data
-        std::vector<CollegeData> collegesData;
-
-        // Static member to track the total number of instances
-        static int totalInstances;
-
-    public:
-        // Parameterized constructor, loads college data from a file
-        RankIntervalStrategy(const std::string& dataFile) {
-            loadCollegesData(dataFile);
-            totalInstances++;
-        }
-
-        // Delegating constructor, uses a default data file
-        RankIntervalStrategy() : RankIntervalStrategy("default_data.txt") {}
-
-        // Override of the virtual function to allocate a college based on rank
-        std::string allocateCollege(int userRank) const override {
-            for (const CollegeData& data : collegesData) {
-                if (userRank >= data.rankStart && userRank <= data.rankEnd) {
-                    return data.college;
-                }
-            }
-            return "No college allocated for your rank.";
-        }
-
-        // Static method to get the total number of instances
-        static int getTotalInstances() {
-            return totalInstances;
-        }
-
-    private:
-        // Private method to load colleges data from a file
-        void loadCollegesData(const std::string& dataFile) {
-            std::ifstream file(dataFile);
-            if (!file.is_open()) {
-                throw std::runtime_error("Error: Cannot open data file.");
-            }
+#include "CollegeCounseling/CollegeCounseling.h"
 
-            std::string line;
-            while (getline(file, line)) {
-                size_t colonPos = line.find(':');
-                if (colonPos == std::string::npos) {
-                    throw std::runtime_error("Error: Invalid data format in the data file.");
-                }
-
-                // Parsing rank range and college name
-                std::string rankRange = line.substr(0, colonPos);
-                std::string college = line.substr(colonPos + 1);
-
-                size_t hyphenPos = rankRange.find('-');
-                if (hyphenPos == std::string::npos) {
-                    throw std::runtime_error("Error: Invalid rank range in the data file.");
-                }
+// Forward declaration for the displayAllocationResult function
+void displayAllocationResult(const std::string& result);
 
-                // Extracting rank start and end values
-                int rankStart = std::stoi(rankRange.substr(0, hyphenPos));
-                int rankEnd = std::stoi(rankRange.substr(hyphenPos + 1));
+// Forward declaration for the runInteractiveCounseling function
+void runInteractiveCounseling(const std::vector<const CollegeCounseling::AllocationStrategy*>& rounds, const std::string& journalPath, std::uint32_t snapshotVersion);
 
-                // Adding college data to the vector
-                collegesData.push_back({ rankStart, rankEnd, college });
-            }
+// Forward declaration for the runBatchAllocation function
+void runBatchAllocation(const CollegeCounseling::CounselingConfig& config, size_t checkpointInterval);
 
-            file.close();
-        }
-    };
+// Forward declaration for the runDryAllocation function
+void runDryAllocation(const CollegeCounseling::CounselingConfig& config, size_t passes);
 
-    // Initializing the static member of RankIntervalStrategy
-    int RankIntervalStrategy::totalInstances = 0;
+// Forward declaration for the reportRoundChanges function
+void reportRoundChanges(const CollegeCounseling::CounselingConfig& config, int roundBefore, int roundAfter);
 
-    // Derived classes with alternative allocation strategies
-    class AnotherStrategy : public AllocationStrategy {
-    public:
-        // Override of the virtual function with a different allocation logic
-        std::string allocateCollege(int userRank) const override {
-            // Implement your allocation logic here
-            return "not eligible for round two";
-        }
-    };
+// Forward declaration for the reportCutoffs function
+void reportCutoffs(const CollegeCounseling::CounselingConfig& config, int round);
 
-    class YetAnotherStrategy : public AllocationStrategy {
-    public:
-        // Override of the virtual function with another allocation logic
-        std::string allocateCollege(int userRank) const override {
-            // Implement your allocation logic here
-            return "not eligible for round three";
-        }
-    };
+// Forward declaration for the runWhatIfSimulation function
+void runWhatIfSimulation(const CollegeCounseling::CounselingConfig& config, size_t scenarioCount, std::uint64_t seed);
 
-    // Class representing a college application
-    class CollegeApplication {
-    private:
-        std::string applicantName;
-        int applicantRank;
+// Forward declaration for the verifyRoundStability function
+bool verifyRoundStability(const CollegeCounseling::CounselingConfig& config, int round, int preferenceWindow);
 
-    public:
-        // Parameterized constructor for creating a college application
-        CollegeApplication(const std::string& name, int rank)
-            : applicantName(name), applicantRank(rank) {}
+// Forward declaration for the searchColleges function
+void searchColleges(const CollegeCounseling::CounselingConfig& config, const std::string& query, const std::string& city);
 
-        // Getter for the applicant's name
-        std::string getApplicantName() const {
-            return applicantName;
-        }
+// Forward declaration for the lookupDatasetRanks function
+void lookupDatasetRanks(const CollegeCounseling::CounselingConfig& config, const CollegeCounseling::DatasetKey& key, const std::vector<int>& ranks);
 
-        // Getter for the applicant's rank
-        int getApplicantRank() const {
-            return applicantRank;
-        }
-    };
+// Forward declaration for the correctSeatMatrix function
+void correctSeatMatrix(const CollegeCounseling::CounselingConfig& config, const std::string& correctionsPath, const std::vector<int>& ranks);
 
-    // Class providing a static method for college allocation
-    class CollegeAdmissionSystem {
-    public:
-        // Static method to allocate a college based on a strategy and application
-        static std::string allocateCollege(const AllocationStrategy& strategy, const CollegeApplication& application) {
-            return strategy.allocateCollege(application.getApplicantRank());
-        }
-    };
-}
+// Forward declaration for the auditRounds function
+void auditRounds(const CollegeCounseling::CounselingConfig& config, const std::vector<int>& ranks);
 
-// Forward declaration for the displayAllocationResult function
-void displayAllocationResult(const std::string& result);
+// Forward declaration for the listRankBand function
+void listRankBand(const CollegeCounseling::CounselingConfig& config, int firstRank, int lastRank);
 
 // Lambda function to get rank allocation using a strategy and application
 auto getRankAllocation = [](const CollegeCounseling::AllocationStrategy& strategy, const CollegeCounseling::CollegeApplication& application) {
@@ -153,65 +55,147 @@ auto getRankAllocation = [](const CollegeCounseling::AllocationStrategy& strateg
 
 
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        std::ifstream pathFile("data.txt");
-        if (!pathFile.is_open()) {
-            throw std::runtime_error("Error: Cannot open data.txt");
+#ifdef COUNSELING_EMBEDDED_MATRIX
+        // Embedded builds answer interactive queries from the compiled-in seat matrix without reading any file
+        if (argc < 2) {
+            CollegeCounseling::EmbeddedIntervalStrategy embeddedStrategy;
+            CollegeCounseling::AnotherStrategy anotherStrategy;
+            CollegeCounseling::YetAnotherStrategy yetAnotherStrategy;
+            runInteractiveCounseling({ &embeddedStrategy, &anotherStrategy, &yetAnotherStrategy }, "allocation_journal.bin",
+                                     embeddedStrategy.getSnapshotVersion());
+            return 0;
         }
+#endif
 
-        std::string projectFilePath;
-        std::getline(pathFile, projectFilePath); // Read the complete path from data.txt
-        pathFile.close();
+        // Every dataset path comes from counseling.conf (or the legacy data.txt); each file is opened once by its loader
+        CollegeCounseling::CounselingConfig config = CollegeCounseling::CounselingConfig::load();
 
-        // Open project.txt using the complete path from data.txt
-        std::ifstream projectFile(projectFilePath);
+        // Batch mode: project --batch [applicants file] [checkpoint interval], the file defaulting to the configured one
+        if (argc >= 2 && std::string(argv[1]) == "--batch") {
+            size_t checkpointInterval = argc >= 4 ? std::stoul(argv[3]) : 100000;
+            if (argc >= 3) {
+                config.applicantFile = argv[2];
+            }
+            runBatchAllocation(config, checkpointInterval);
+            return 0;
+        }
 
-        if (!projectFile.is_open()) {
-            throw std::runtime_error("Error: Cannot open project.txt");
+        // Dry run: project --dry-run <applicants file> [passes], parses and allocates without writing any file
+        if (argc >= 3 && std::string(argv[1]) == "--dry-run") {
+            config.applicantFile = argv[2];
+            runDryAllocation(config, argc >= 4 ? std::stoul(argv[3]) : 1);
+            return 0;
         }
 
-       
+        // Change report: project --diff <applicants file> <round> <round>
+        if (argc >= 5 && std::string(argv[1]) == "--diff") {
+            config.applicantFile = argv[2];
+            reportRoundChanges(config, std::stoi(argv[3]), std::stoi(argv[4]));
+            return 0;
+        }
 
-        // Close project.txt
-        projectFile.close();
+        // Cutoff report: project --analytics <applicants file> <round>
+        if (argc >= 4 && std::string(argv[1]) == "--analytics") {
+            config.applicantFile = argv[2];
+            reportCutoffs(config, std::stoi(argv[3]));
+            return 0;
+        }
 
-        // Rest of the code remains the same
+        // What-if simulation: project --simulate <applicants file> <scenarios> [seed]
+        if (argc >= 4 && std::string(argv[1]) == "--simulate") {
+            std::uint64_t seed = argc >= 5 ? std::stoull(argv[4]) : 1;
+            config.applicantFile = argv[2];
+            runWhatIfSimulation(config, std::stoul(argv[3]), seed);
+            return 0;
+        }
 
-        // User input for name
-        std::cout << "Enter your name: ";
-        std::string userName;
-        std::getline(std::cin >> std::ws, userName); // Allowing spaces in the name
+        // Stability certificate: project --verify <applicants file> <round> [preference window], the
+        // window defaulting to the simulator's; 0 checks each applicant's own college and seats only
+        if (argc >= 4 && std::string(argv[1]) == "--verify") {
+            config.applicantFile = argv[2];
+            int window = argc >= 5 ? std::stoi(argv[4]) : CollegeCounseling::ScenarioSettings().preferenceWindow;
+            return verifyRoundStability(config, std::stoi(argv[3]), window) ? 0 : 1;
+        }
 
-        // User input for rank
-        std::cout << "Enter your rank: ";
-        int userRank;
-        if (!(std::cin >> userRank)) {
-        // If reading fails, throw an exception
-        throw std::runtime_error("Error: Invalid input for rank. Please enter a valid integer.");
-    }
+        // College search: project --search <partial name> [city]
+        if (argc >= 3 && std::string(argv[1]) == "--search") {
+            searchColleges(config, argv[2], argc >= 4 ? argv[3] : "");
+            return 0;
+        }
 
-        // Creating instances of different strategies and a college application
-        CollegeCounseling::RankIntervalStrategy rankStrategy(projectFilePath);
-        CollegeCounseling::AnotherStrategy anotherStrategy;
-        CollegeCounseling::YetAnotherStrategy yetAnotherStrategy;
-        CollegeCounseling::CollegeApplication application(userName, userRank);
+        // Rank band listing: project --band <first rank> <last rank>
+        if (argc >= 4 && std::string(argv[1]) == "--band") {
+            listRankBand(config, std::stoi(argv[2]), std::stoi(argv[3]));
+            return 0;
+        }
+
+        // Registry lookup: project --lookup <board> <year> <round> <rank>...
+        if (argc >= 6 && std::string(argv[1]) == "--lookup") {
+            std::vector<int> ranks;
+            for (int i = 5; i < argc; ++i) {
+                ranks.push_back(std::stoi(argv[i]));
+            }
+            lookupDatasetRanks(config, { argv[2], std::stoi(argv[3]), std::stoi(argv[4]) }, ranks);
+            return 0;
+        }
+
+        // Seat-matrix corrections: project --correct <corrections file> <rank>...
+        if (argc >= 4 && std::string(argv[1]) == "--correct") {
+            std::vector<int> ranks;
+            for (int i = 3; i < argc; ++i) {
+                ranks.push_back(std::stoi(argv[i]));
+            }
+            correctSeatMatrix(config, argv[2], ranks);
+            return 0;
+        }
+
+        // Round history audit: project --audit <rank>...
+        if (argc >= 3 && std::string(argv[1]) == "--audit") {
+            std::vector<int> ranks;
+            for (int i = 2; i < argc; ++i) {
+                ranks.push_back(std::stoi(argv[i]));
+            }
+            auditRounds(config, ranks);
+            return 0;
+        }
 
-        // Getting and displaying the result for each strategy
-        std::string resultRank = getRankAllocation(rankStrategy, application);
-        displayAllocationResult(resultRank);
+        // Embedded header generation: project --embed <output header>
+        if (argc >= 3 && std::string(argv[1]) == "--embed") {
+            CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+            std::ofstream header(argv[2]);
+            if (!header.is_open()) {
+                throw std::runtime_error("Error: Cannot write embedded header.");
+            }
+            CollegeCounseling::EmbeddedMatrixGenerator::write(rankStrategy, config.seatMatrix(1), header);
+            return 0;
+        }
 
-        std::string resultAnother = getRankAllocation(anotherStrategy, application);
-        displayAllocationResult(resultAnother);
+        // Sectioned snapshot generation: project --section <output file> [rows per section]
+        if (argc >= 3 && std::string(argv[1]) == "--section") {
+            CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+            std::ofstream snapshot(argv[2], std::ios::binary);
+            if (!snapshot.is_open()) {
+                throw std::runtime_error("Error: Cannot write sectioned snapshot.");
+            }
+            rankStrategy.writeSectioned(snapshot, argc >= 4 ? static_cast<size_t>(std::stoul(argv[3])) : 4096);
+            std::cout << "Wrote " << rankStrategy.getCollegeCount() << " colleges to " << argv[2] << std::endl;
+            return 0;
+        }
 
-        std::string resultYetAnother = getRankAllocation(yetAnotherStrategy, application);
-        displayAllocationResult(resultYetAnother);
+        // Rest of the code remains the same
+        CollegeCounseling::AnotherStrategy anotherStrategy;
+        CollegeCounseling::YetAnotherStrategy yetAnotherStrategy;
+        CollegeCounseling::RoundStrategies strategies(config, { nullptr, &anotherStrategy, &yetAnotherStrategy });
+        runInteractiveCounseling(strategies.getRounds(), config.journalPath, strategies.getSnapshotVersion());
 
         // Displaying the total instances of RankIntervalStrategy
         std::cout << "Total instances of RankIntervalStrategy: " << CollegeCounseling::RankIntervalStrategy::getTotalInstances() << std::endl;
     } catch (const std::exception& e) {
         // Handling exceptions and displaying error messages
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 
     return 0;
@@ -222,3 +206,283 @@ int main() {
 void displayAllocationResult(const std::string& result) {
     std::cout << "Result: " << result << std::endl;
 }
+
+// Definition of the runInteractiveCounseling function, asks for one applicant and runs every round
+void runInteractiveCounseling(const std::vector<const CollegeCounseling::AllocationStrategy*>& rounds, const std::string& journalPath, std::uint32_t snapshotVersion) {
+    // User input for name
+    std::cout << "Enter your name: ";
+    std::string userName;
+    std::getline(std::cin >> std::ws, userName); // Allowing spaces in the name
+
+    // User input for rank
+    std::cout << "Enter your rank: ";
+    int userRank;
+    if (!(std::cin >> userRank)) {
+        // If reading fails, throw an exception
+        throw std::runtime_error("Error: Invalid input for rank. Please enter a valid integer.");
+    }
+
+    // Creating a college application
+    CollegeCounseling::CollegeApplication application(userName, userRank);
+
+    // Journal receiving every round's decision so results survive a crash
+    CollegeCounseling::AllocationJournal journal(journalPath);
+
+    // Getting and displaying the result for each round's strategy
+    for (size_t round = 0; round < rounds.size(); ++round) {
+        const CollegeCounseling::AllocationStrategy& strategy = *rounds[round];
+        std::string result = getRankAllocation(strategy, application);
+        journal.append({ application.getApplicantId(), static_cast<std::int32_t>(round + 1),
+                         strategy.allocateCollegeId(application.getApplicantRank()), snapshotVersion });
+        displayAllocationResult(result);
+    }
+
+    // One fsync covers every round
+    journal.commit();
+}
+
+// Definition of the runBatchAllocation function, resumes from round_checkpoint.bin when one is left behind
+void runBatchAllocation(const CollegeCounseling::CounselingConfig& config, size_t checkpointInterval) {
+    if (config.applicantFile.empty()) {
+        throw std::runtime_error("Error: No applicant file given or configured.");
+    }
+    CollegeCounseling::AnotherStrategy anotherStrategy;
+    CollegeCounseling::YetAnotherStrategy yetAnotherStrategy;
+    CollegeCounseling::RoundStrategies strategies(config, { nullptr, &anotherStrategy, &yetAnotherStrategy });
+    std::vector<CollegeCounseling::CollegeApplication> applications = CollegeCounseling::ApplicantLoader::load(
+        CollegeCounseling::MappedFile::open(config.applicantFile));
+
+    CollegeCounseling::RoundPipeline pipeline(strategies.getRounds(), strategies.getCollegeCount(), strategies.getSnapshotVersion());
+    CollegeCounseling::RoundState state;
+    if (CollegeCounseling::CheckpointWriter::load(config.checkpointPath, state) && pipeline.canResume(state, applications.size())) {
+        std::cout << "Resuming at round " << state.round + 1 << ", applicant " << state.cursor << std::endl;
+    } else {
+        state = pipeline.initialState(applications.size());
+    }
+
+    CollegeCounseling::AllocationJournal journal(config.journalPath);
+    CollegeCounseling::CheckpointWriter checkpoints(config.checkpointPath);
+    pipeline.run(applications, state, &journal, &checkpoints, checkpointInterval);
+    checkpoints.discard();
+
+    // Keep every round's result as deltas against the previous round
+    CollegeCounseling::RoundDeltaStore resultStore;
+    for (const std::vector<std::int32_t>& roundMatching : state.matching) {
+        resultStore.appendRound(roundMatching);
+    }
+    resultStore.save(config.resultsPath);
+
+    for (size_t round = 0; round < state.matching.size(); ++round) {
+        size_t allocated = std::count_if(state.matching[round].begin(), state.matching[round].end(),
+                                         [](std::int32_t id) { return id != CollegeCounseling::AllocationStrategy::noCollegeId; });
+        std::cout << "Round " << round + 1 << ": " << allocated << " of " << applications.size() << " applicants allocated" << std::endl;
+    }
+}
+
+// Definition of the runDryAllocation function, repeats the CSV parse and the batched round 1 lookups
+// with no journal, checkpoint or result file, so its time is spent in the parse and lookup loops
+void runDryAllocation(const CollegeCounseling::CounselingConfig& config, size_t passes) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    size_t applicantCount = 0;
+    size_t allocated = 0;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        CollegeCounseling::ApplicantColumns columns = CollegeCounseling::ApplicantCsvParser::parseFile(config.applicantFile);
+        std::vector<std::int32_t> collegeIds(columns.size());
+        rankStrategy.allocateCollegeIds(columns.ranks.data(), collegeIds.data(), columns.size());
+        applicantCount = columns.size();
+        allocated = static_cast<size_t>(std::count_if(collegeIds.begin(), collegeIds.end(),
+            [](std::int32_t id) { return id != CollegeCounseling::AllocationStrategy::noCollegeId; }));
+    }
+    std::cout << allocated << " of " << applicantCount << " applicants allocated in " << passes << " passes" << std::endl;
+}
+
+// Definition of the reportRoundChanges function, lists applicants whose college changed between two batch rounds
+void reportRoundChanges(const CollegeCounseling::CounselingConfig& config, int roundBefore, int roundAfter) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    std::vector<CollegeCounseling::CollegeApplication> applications = CollegeCounseling::ApplicantLoader::load(
+        CollegeCounseling::MappedFile::open(config.applicantFile));
+    CollegeCounseling::RoundDeltaStore resultStore = CollegeCounseling::RoundDeltaStore::load(config.resultsPath);
+    if (resultStore.getApplicantCount() != applications.size() || roundBefore < 1 || roundAfter < 1) {
+        throw std::runtime_error("Error: Round results do not match the applicant file.");
+    }
+
+    auto collegeName = [&rankStrategy](std::int32_t collegeId) -> std::string {
+        if (collegeId == CollegeCounseling::AllocationStrategy::noCollegeId || collegeId >= rankStrategy.getCollegeCount()) {
+            return "No college";
+        }
+        return rankStrategy.getCollegeName(collegeId);
+    };
+
+    std::vector<std::int32_t> before = resultStore.materialize(static_cast<size_t>(roundBefore - 1));
+    std::vector<std::int32_t> after = resultStore.materialize(static_cast<size_t>(roundAfter - 1));
+    size_t changes = CollegeCounseling::RoundDiff::compare(before, after, [&](const CollegeCounseling::AllocationChange& change) {
+        const CollegeCounseling::CollegeApplication& application = applications[change.applicantIndex];
+        std::cout << application.getApplicantId() << " " << application.getApplicantName() << ": "
+                  << collegeName(change.before) << " -> " << collegeName(change.after) << "\n";
+    });
+    std::cout << changes << " applicants changed" << std::endl;
+}
+
+// Definition of the reportCutoffs function, prints per-college cutoffs and fill for one batch round
+void reportCutoffs(const CollegeCounseling::CounselingConfig& config, int round) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    std::vector<CollegeCounseling::CollegeApplication> applications = CollegeCounseling::ApplicantLoader::load(
+        CollegeCounseling::MappedFile::open(config.applicantFile));
+    CollegeCounseling::RoundDeltaStore resultStore = CollegeCounseling::RoundDeltaStore::load(config.resultsPath);
+    if (resultStore.getApplicantCount() != applications.size() || round < 1) {
+        throw std::runtime_error("Error: Round results do not match the applicant file.");
+    }
+
+    CollegeCounseling::CutoffReport report = CollegeCounseling::CutoffAnalytics::compute(
+        applications, resultStore.materialize(static_cast<size_t>(round - 1)), rankStrategy.getCollegeCount());
+
+    std::cout << "id,college,opening,closing,filled";
+    for (const std::string& category : report.categories) {
+        std::cout << "," << category;
+    }
+    std::cout << ",histogram\n";
+    for (size_t id = 0; id < report.colleges.size(); ++id) {
+        const CollegeCounseling::CollegeCutoff& cutoff = report.colleges[id];
+        std::cout << id << ",\"" << rankStrategy.getCollegeName(static_cast<int>(id)) << "\"," << cutoff.openingRank << ","
+                  << cutoff.closingRank << "," << cutoff.seatsFilled;
+        for (std::int64_t seats : cutoff.seatsByCategory) {
+            std::cout << "," << seats;
+        }
+        std::cout << ",";
+        for (size_t bucket = 0; bucket < cutoff.rankHistogram.size(); ++bucket) {
+            std::cout << (bucket ? " " : "") << cutoff.rankHistogram[bucket];
+        }
+        std::cout << "\n";
+    }
+    std::cout.flush();
+}
+
+// Definition of the runWhatIfSimulation function, prints closing-rank and fill distributions per college
+void runWhatIfSimulation(const CollegeCounseling::CounselingConfig& config, size_t scenarioCount, std::uint64_t seed) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    std::vector<CollegeCounseling::CollegeApplication> applications = CollegeCounseling::ApplicantLoader::load(
+        CollegeCounseling::MappedFile::open(config.applicantFile));
+    CollegeCounseling::WhatIfSimulator simulator(rankStrategy, applications);
+    CollegeCounseling::SimulationSummary summary = simulator.run(scenarioCount, seed);
+
+    std::cout << "id,college,mean filled,closing p10,closing p50,closing p90\n";
+    for (int id = 0; id < rankStrategy.getCollegeCount(); ++id) {
+        std::cout << id << ",\"" << rankStrategy.getCollegeName(id) << "\"," << summary.meanSeatsFilled[id] << ","
+                  << summary.closingRankQuantile(id, 0.1) << "," << summary.closingRankQuantile(id, 0.5) << ","
+                  << summary.closingRankQuantile(id, 0.9) << "\n";
+    }
+    std::vector<std::int64_t> unallocated = summary.unallocated;
+    std::sort(unallocated.begin(), unallocated.end());
+    if (!unallocated.empty()) {
+        std::cout << "unallocated min/median/max: " << unallocated.front() << "/" << unallocated[unallocated.size() / 2]
+                  << "/" << unallocated.back() << std::endl;
+    }
+}
+
+// Definition of the verifyRoundStability function, checks a batch round against the seats of its matrix
+// (one per rank in a college's interval) and the preference model of the simulator: each applicant
+// lists the colleges within the window of the one their rank maps to, or only that college for window 0
+bool verifyRoundStability(const CollegeCounseling::CounselingConfig& config, int round, int preferenceWindow) {
+    CollegeCounseling::AnotherStrategy anotherStrategy;
+    CollegeCounseling::YetAnotherStrategy yetAnotherStrategy;
+    CollegeCounseling::RoundStrategies strategies(config, { nullptr, &anotherStrategy, &yetAnotherStrategy });
+    const CollegeCounseling::RankIntervalStrategy& rankStrategy = strategies.getPrimary();
+    std::vector<CollegeCounseling::CollegeApplication> applications = CollegeCounseling::ApplicantLoader::load(
+        CollegeCounseling::MappedFile::open(config.applicantFile));
+    CollegeCounseling::RoundDeltaStore resultStore = CollegeCounseling::RoundDeltaStore::load(config.resultsPath);
+    if (resultStore.getApplicantCount() != applications.size() || round < 1
+        || static_cast<size_t>(round) > strategies.getRounds().size()) {
+        throw std::runtime_error("Error: Round results do not match the applicant file.");
+    }
+
+    // Rounds without a seat matrix of their own are checked against round 1's seats
+    const CollegeCounseling::AllocationStrategy& roundStrategy = *strategies.getRounds()[static_cast<size_t>(round - 1)];
+    const auto* roundMatrix = dynamic_cast<const CollegeCounseling::RankIntervalStrategy*>(&roundStrategy);
+    const CollegeCounseling::RankIntervalStrategy& seatMatrix = roundMatrix ? *roundMatrix : rankStrategy;
+    std::vector<int> capacities(static_cast<size_t>(strategies.getCollegeCount()), 0);
+    for (int id = 0; id < seatMatrix.getCollegeCount(); ++id) {
+        capacities[static_cast<size_t>(id)] = std::max(0, seatMatrix.getCollegeCapacity(id));
+    }
+
+    CollegeCounseling::ScenarioSettings settings;
+    CollegeCounseling::StabilityReport report = CollegeCounseling::StabilityVerifier::verify(
+        CollegeCounseling::LotteryTieBreaker(settings.tieBreakSeed).meritOrder(applications),
+        preferenceWindow > 0 ? CollegeCounseling::PreferenceTable::fromRankIntervals(seatMatrix, applications, preferenceWindow)
+                             : CollegeCounseling::PreferenceTable::fromRoundStrategy(roundStrategy, applications),
+        capacities, resultStore.materialize(static_cast<size_t>(round - 1)));
+
+    for (std::int32_t collegeId : report.overfilledColleges) {
+        std::cout << "Overfilled: " << rankStrategy.getCollegeName(collegeId) << "\n";
+    }
+    for (size_t applicant : report.unlistedAssignments) {
+        std::cout << "Unlisted assignment: applicant " << applications[applicant].getApplicantId() << "\n";
+    }
+    for (const CollegeCounseling::BlockingPair& pair : report.blockingPairs) {
+        std::cout << "Blocking pair: applicant " << applications[pair.applicantIndex].getApplicantId() << " with "
+                  << rankStrategy.getCollegeName(pair.collegeId) << "\n";
+    }
+    std::cout << (report.isStable() ? "Round is stable" : "Round is NOT stable") << std::endl;
+    return report.isStable();
+}
+
+// Definition of the searchColleges function, lists colleges matching a partial name and optional city
+void searchColleges(const CollegeCounseling::CounselingConfig& config, const std::string& query, const std::string& city) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    CollegeCounseling::CollegeSearchIndex searchIndex(rankStrategy);
+    for (std::int32_t collegeId : searchIndex.search(query, city)) {
+        std::cout << collegeId << ":" << rankStrategy.getCollegeName(collegeId) << "\n";
+    }
+    std::cout.flush();
+}
+
+// Definition of the listRankBand function, lists the colleges whose intervals overlap a rank band
+void listRankBand(const CollegeCounseling::CounselingConfig& config, int firstRank, int lastRank) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    size_t count = 0;
+    for (const CollegeCounseling::RankIntervalStrategy::BandInterval& interval : rankStrategy.scanBand(firstRank, lastRank)) {
+        std::cout << interval.collegeId << ": " << interval.rankStart << "-" << interval.rankEnd << ":" << *interval.college << "\n";
+        ++count;
+    }
+    std::cout << count << " colleges between rank " << firstRank << " and " << lastRank << std::endl;
+}
+
+// Definition of the lookupDatasetRanks function, answers ranks from one of the configured registry datasets
+void lookupDatasetRanks(const CollegeCounseling::CounselingConfig& config, const CollegeCounseling::DatasetKey& key, const std::vector<int>& ranks) {
+    CollegeCounseling::DatasetRegistry registry(config.datasetMemoryBudget, config.datasetIndex);
+    for (const auto& dataset : config.datasets) {
+        registry.add(dataset.first, dataset.second);
+    }
+    std::shared_ptr<const CollegeCounseling::AllocationStrategy> strategy = registry.get(key);
+    for (int rank : ranks) {
+        std::cout << rank << ": " << strategy->allocateCollege(rank) << "\n";
+    }
+    std::cout.flush();
+}
+
+// Definition of the correctSeatMatrix function, applies a corrections file to the round 1 seat matrix and answers ranks from the result
+void correctSeatMatrix(const CollegeCounseling::CounselingConfig& config, const std::string& correctionsPath, const std::vector<int>& ranks) {
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::open(config.seatMatrix(1)));
+    CollegeCounseling::DynamicIntervalIndex index(rankStrategy);
+    std::ifstream corrections(correctionsPath);
+    if (!corrections.is_open()) {
+        throw std::runtime_error("Error: Cannot open corrections file " + correctionsPath);
+    }
+    size_t applied = CollegeCounseling::applySeatCorrections(index, corrections);
+    std::cout << "Applied " << applied << " corrections, " << index.getIntervalCount() << " intervals live\n";
+    for (int rank : ranks) {
+        std::cout << rank << ": " << index.allocateCollege(rank) << "\n";
+    }
+    std::cout.flush();
+}
+
+// Definition of the auditRounds function, answers ranks from every configured round's seat matrix and reports the history's memory
+void auditRounds(const CollegeCounseling::CounselingConfig& config, const std::vector<int>& ranks) {
+    CollegeCounseling::SeatMatrixHistory history = CollegeCounseling::SeatMatrixHistory::fromConfig(config);
+    for (const auto& round : history.getRounds()) {
+        std::cout << "Round " << round.first << " (" << round.second.getIntervalCount() << " intervals)\n";
+        for (int rank : ranks) {
+            std::cout << "  " << rank << ": " << round.second.allocateCollege(rank) << "\n";
+        }
+    }
+    std::cout << "History holds " << history.getSharedBytes() << " bytes, " << history.getUnsharedBytes() << " as separate copies" << std::endl;
+}
@@ -0,0 +1,145 @@
+#define COLLEGE_COUNSELING_C_BUILD
+#include "college_counseling.h"
+
+#include <exception>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "CollegeCounseling/RankIntervalStrategy.h"
+
+static_assert(std::is_same<int, std::int32_t>::value, "The C ABI exposes rank boundaries as int32_t");
+
+struct cc_seat_matrix {
+    CollegeCounseling::RankIntervalStrategy strategy;
+
+    explicit cc_seat_matrix(const char* path) : strategy(path) {}
+};
+
+namespace {
+    // Per-thread message for cc_last_error
+    thread_local std::string lastError;
+
+    cc_status fail(cc_status status, const char* message) {
+        lastError = message;
+        return status;
+    }
+
+    // Runs the body of an entry point. Queries on a sectioned snapshot parse sections on first
+    // use, so any of them can meet a corrupt section or run out of memory; neither may unwind
+    // into the C caller.
+    template <typename Body>
+    cc_status guarded(Body body) {
+        try {
+            return body();
+        } catch (const std::bad_alloc&) {
+            return fail(CC_LOAD_FAILED, "Error: Out of memory.");
+        } catch (const std::exception& e) {
+            return fail(CC_LOAD_FAILED, e.what());
+        }
+    }
+}
+
+extern "C" {
+
+cc_status cc_seat_matrix_open(const char* path, cc_seat_matrix** matrix) {
+    if (!path || !matrix) {
+        return fail(CC_INVALID_ARGUMENT, "Error: Seat matrix path and handle are required.");
+    }
+    *matrix = nullptr;
+    try {
+        *matrix = new cc_seat_matrix(path);
+    } catch (const std::exception& e) {
+        return fail(CC_LOAD_FAILED, e.what());
+    }
+    lastError.clear();
+    return CC_OK;
+}
+
+void cc_seat_matrix_close(cc_seat_matrix* matrix) {
+    delete matrix;
+}
+
+const char* cc_last_error(void) {
+    return lastError.c_str();
+}
+
+int32_t cc_college_count(const cc_seat_matrix* matrix) {
+    return matrix ? matrix->strategy.getCollegeCount() : 0;
+}
+
+uint32_t cc_snapshot_version(const cc_seat_matrix* matrix) {
+    return matrix ? matrix->strategy.getSnapshotVersion() : 0;
+}
+
+cc_status cc_allocate_ids(const cc_seat_matrix* matrix, const int32_t* ranks, int32_t* college_ids, size_t count) {
+    if (!matrix || (count && (!ranks || !college_ids))) {
+        return fail(CC_INVALID_ARGUMENT, "Error: Matrix and rank/ID buffers are required.");
+    }
+    return guarded([&] {
+        matrix->strategy.allocateCollegeIds(ranks, college_ids, count);
+        return CC_OK;
+    });
+}
+
+int32_t cc_find_college(const cc_seat_matrix* matrix, const char* name, size_t length) {
+    if (!matrix || (length && !name)) {
+        return CC_NO_COLLEGE;
+    }
+    int32_t collegeId = CC_NO_COLLEGE;
+    guarded([&] {
+        collegeId = matrix->strategy.findCollegeId(std::string(name, length));
+        return CC_OK;
+    });
+    return collegeId;
+}
+
+cc_status cc_college_name(const cc_seat_matrix* matrix, int32_t college_id, char* buffer, size_t capacity, size_t* length) {
+    if (!matrix || !length || college_id < 0 || college_id >= matrix->strategy.getCollegeCount() || (capacity && !buffer)) {
+        return fail(CC_INVALID_ARGUMENT, "Error: Invalid college ID or name buffer.");
+    }
+    return guarded([&] {
+        const std::string& name = matrix->strategy.getCollegeName(college_id);
+        *length = name.size();
+        if (capacity < name.size()) {
+            return fail(CC_BUFFER_TOO_SMALL, "Error: Name buffer is too small.");
+        }
+        name.copy(buffer, name.size());
+        return CC_OK;
+    });
+}
+
+cc_status cc_band(const cc_seat_matrix* matrix, int32_t first_rank, int32_t last_rank, int32_t* college_ids, size_t capacity,
+                  size_t* count) {
+    if (!matrix || !count || (capacity && !college_ids)) {
+        return fail(CC_INVALID_ARGUMENT, "Error: Matrix, count and ID buffer are required.");
+    }
+    return guarded([&] {
+        size_t found = 0;
+        for (const auto& interval : matrix->strategy.scanBand(first_rank, last_rank)) {
+            if (found < capacity) {
+                college_ids[found] = interval.collegeId;
+            }
+            ++found;
+        }
+        *count = found;
+        if (found > capacity) {
+            return fail(CC_BUFFER_TOO_SMALL, "Error: College ID buffer is too small.");
+        }
+        return CC_OK;
+    });
+}
+
+cc_status cc_segments(const cc_seat_matrix* matrix, const int32_t** starts, const int32_t** ids, size_t* count) {
+    if (!matrix || !starts || !ids || !count) {
+        return fail(CC_INVALID_ARGUMENT, "Error: Matrix and output pointers are required.");
+    }
+    return guarded([&] {
+        *starts = matrix->strategy.getSegmentStarts().data();
+        *ids = matrix->strategy.getSegmentIds().data();
+        *count = matrix->strategy.getSegmentStarts().size();
+        return CC_OK;
+    });
+}
+
+}
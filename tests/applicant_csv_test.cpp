@@ -0,0 +1,170 @@
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/ApplicantCsv.h"
+#include "check.h"
+
+using CollegeCounseling::ApplicantColumns;
+using CollegeCounseling::ApplicantCsvParser;
+using CollegeCounseling::ApplicantLoader;
+using CollegeCounseling::CollegeApplication;
+using CollegeCounseling::MappedFile;
+
+namespace {
+    ApplicantColumns parse(const std::string& contents) {
+        return ApplicantCsvParser::parseFile(MappedFile::fromString(contents));
+    }
+
+    std::vector<CollegeApplication> load(const std::string& contents) {
+        return ApplicantLoader::load(MappedFile::fromString(contents));
+    }
+
+    void testPlainRows() {
+        ApplicantColumns columns = parse("Asha,12\nRavi,7,SC\n");
+        CHECK(columns.size() == 2);
+        CHECK(columns.name(0) == "Asha");
+        CHECK(columns.ranks[0] == 12);
+        CHECK(columns.category(0) == "GM");
+        CHECK(columns.name(1) == "Ravi");
+        CHECK(columns.ranks[1] == 7);
+        CHECK(columns.category(1) == "SC");
+    }
+
+    void testHeaderRow() {
+        ApplicantColumns columns = parse("name,rank,category\nAsha,12,GM\n");
+        CHECK(columns.size() == 1);
+        CHECK(columns.name(0) == "Asha");
+
+        // A first line with a digit is data, not a header
+        CHECK(parse("Asha,1\nRavi,2\n").size() == 2);
+    }
+
+    void testQuotedFields() {
+        ApplicantColumns columns = parse("\"Rao, Asha\",12\n\"Said \"\"Ravi\"\"\",7,OBC\n");
+        CHECK(columns.size() == 2);
+        CHECK(columns.name(0) == "Rao, Asha");
+        CHECK(columns.ranks[0] == 12);
+        CHECK(columns.name(1) == "Said \"Ravi\"");
+        CHECK(columns.category(1) == "OBC");
+
+        // A quoted newline stays inside the field
+        ApplicantColumns multiline = parse("\"Asha\nRao\",3\n");
+        CHECK(multiline.size() == 1);
+        CHECK(multiline.name(0) == "Asha\nRao");
+    }
+
+    void testUnquotedCommasInName() {
+        // Fields resolve from the right, so an unquoted name may hold commas
+        ApplicantColumns columns = parse("Rao, Asha,12,SC\n");
+        CHECK(columns.size() == 1);
+        CHECK(columns.name(0) == "Rao, Asha");
+        CHECK(columns.ranks[0] == 12);
+        CHECK(columns.category(0) == "SC");
+    }
+
+    void testCategoriesWithDigits() {
+        // KCET categories such as 1G and 2AG hold digits; the rank is the rightmost all-digit field
+        ApplicantColumns columns = parse("Asha,120,2AG\nMeena,77,1G\nRavi,55,SC\nRao, 3BG,9,3BG\n");
+        CHECK(columns.size() == 4);
+        CHECK(columns.name(0) == "Asha");
+        CHECK(columns.ranks[0] == 120);
+        CHECK(columns.category(0) == "2AG");
+        CHECK(columns.ranks[1] == 77);
+        CHECK(columns.category(1) == "1G");
+        CHECK(columns.category(2) == "SC");
+        CHECK(columns.name(3) == "Rao, 3BG");
+        CHECK(columns.ranks[3] == 9);
+        CHECK(columns.category(3) == "3BG");
+    }
+
+    void testExtraColumns() {
+        // Non-numeric columns after the category are ignored
+        ApplicantColumns columns = parse("name,rank,category,board\nAsha,12,GM,KCET\nRavi,7,2AG,note 5\nMeena,3,SC,\n");
+        CHECK(columns.size() == 3);
+        CHECK(columns.name(0) == "Asha");
+        CHECK(columns.ranks[0] == 12);
+        CHECK(columns.category(0) == "GM");
+        CHECK(columns.ranks[1] == 7);
+        CHECK(columns.category(1) == "2AG");
+        CHECK(columns.name(2) == "Meena");
+    }
+
+    void testLineEndings() {
+        ApplicantColumns columns = parse("name,rank\r\nAsha,12\r\n\r\nRavi,7,SC\r\nMeera,9");
+        CHECK(columns.size() == 3);
+        CHECK(columns.name(0) == "Asha");
+        CHECK(columns.ranks[0] == 12);
+        CHECK(columns.category(1) == "SC");
+        CHECK(columns.name(2) == "Meera");
+        CHECK(columns.ranks[2] == 9);
+    }
+
+    void testLongRanks() {
+        ApplicantColumns columns = parse("A,12345678\nB,123456789\nC,2147483647\nD, 0042 \n");
+        CHECK(columns.size() == 4);
+        CHECK(columns.ranks[0] == 12345678);
+        CHECK(columns.ranks[1] == 123456789);
+        CHECK(columns.ranks[2] == 2147483647);
+        CHECK(columns.ranks[3] == 42);
+
+        CHECK_THROWS(parse("A,2147483648\n"));
+        CHECK_THROWS(parse("A,12x4\n"));
+        CHECK_THROWS(parse("A,-3\n"));
+    }
+
+    void testMalformedRows() {
+        CHECK_THROWS(parse("Asha,\"Rao,12\n"));
+        CHECK_THROWS(parse("\"Asha,12\nRavi,7\n"));
+        CHECK_THROWS(parse("name,rank\nAsha\n"));
+        CHECK_THROWS(parse("name,rank\nAsha,SC\n"));
+    }
+
+    void testBlockBoundaries() {
+        // Quoted fields straddling the 64-byte scan blocks must keep their commas hidden
+        std::string contents;
+        std::vector<std::string> names;
+        for (int row = 0; row < 200; ++row) {
+            std::string name = "Name " + std::string(static_cast<size_t>(row % 37), 'x') + ", part " + std::to_string(row);
+            names.push_back(name);
+            contents += "\"" + name + "\"," + std::to_string(row * 1000003 % 99999991) + (row % 3 == 0 ? ",EWS" : "") + "\n";
+        }
+        ApplicantColumns columns = parse(contents);
+        CHECK(columns.size() == names.size());
+        for (size_t row = 0; row < names.size() && row < columns.size(); ++row) {
+            CHECK(columns.name(row) == names[row]);
+            CHECK(columns.ranks[row] == static_cast<int>(row * 1000003 % 99999991));
+            CHECK(columns.category(row) == (row % 3 == 0 ? "EWS" : "GM"));
+        }
+    }
+
+    void testLoaderIds() {
+        // Applicants are numbered by row, so tied ranks keep distinct IDs
+        std::vector<CollegeApplication> applications = load("name,rank\nA,5\nB,5\nC,5\n");
+        CHECK(applications.size() == 3);
+        for (size_t row = 0; row < applications.size(); ++row) {
+            CHECK(applications[row].getApplicantId() == static_cast<int>(row + 1));
+            CHECK(applications[row].getApplicantRank() == 5);
+        }
+    }
+
+    void testEmptyInput() {
+        CHECK(parse("").size() == 0);
+        CHECK(parse("name,rank,category\n").size() == 0);
+    }
+}
+
+int main() {
+    testPlainRows();
+    testHeaderRow();
+    testQuotedFields();
+    testUnquotedCommasInName();
+    testCategoriesWithDigits();
+    testExtraColumns();
+    testLineEndings();
+    testLongRanks();
+    testMalformedRows();
+    testBlockBoundaries();
+    testLoaderIds();
+    testEmptyInput();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "college_counseling.h"
+#include "check.h"
+
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    const std::string snapshotPath = "c_api_test.snapshot";
+
+    // Writes a sectioned snapshot of four colleges, two per section, with the given bytes
+    // replaced in its body
+    void writeSnapshot(const std::string& from, const std::string& to) {
+        RankIntervalStrategy table(MappedFile::fromString("1-10:A\n11-20:B\n21-30:C\n31-40:D\n"));
+        std::ostringstream out;
+        table.writeSectioned(out, 2);
+        std::string bytes = out.str();
+        size_t at = bytes.find(from);
+        if (at != std::string::npos) {
+            bytes.replace(at, from.size(), to);
+        }
+        std::ofstream(snapshotPath, std::ios::binary) << bytes;
+    }
+
+    void testQueries() {
+        writeSnapshot("", "");
+        cc_seat_matrix* matrix = nullptr;
+        CHECK(cc_seat_matrix_open(snapshotPath.c_str(), &matrix) == CC_OK);
+        if (!matrix) {
+            return;
+        }
+        std::int32_t ranks[3] = { 5, 35, 99 };
+        std::int32_t ids[3] = {};
+        CHECK(cc_allocate_ids(matrix, ranks, ids, 3) == CC_OK);
+        CHECK(ids[0] == 0 && ids[1] == 3 && ids[2] == CC_NO_COLLEGE);
+        CHECK(cc_find_college(matrix, "C", 1) == 2);
+
+        char name[4];
+        size_t length = 0;
+        CHECK(cc_college_name(matrix, 1, name, 0, &length) == CC_BUFFER_TOO_SMALL);
+        CHECK(length == 1);
+        CHECK(cc_college_name(matrix, 1, name, sizeof(name), &length) == CC_OK);
+        CHECK(name[0] == 'B');
+
+        size_t count = 0;
+        CHECK(cc_band(matrix, 15, 25, ids, 3, &count) == CC_OK);
+        CHECK(count == 2 && ids[0] == 1 && ids[1] == 2);
+        cc_seat_matrix_close(matrix);
+    }
+
+    void testCorruptSectionIsReported() {
+        // The section index is intact, so opening succeeds; the damage shows on first use
+        writeSnapshot("31-40:D", "xx-40:D");
+        cc_seat_matrix* matrix = nullptr;
+        CHECK(cc_seat_matrix_open(snapshotPath.c_str(), &matrix) == CC_OK);
+        if (!matrix) {
+            return;
+        }
+        std::int32_t ranks[2] = { 5, 35 };
+        std::int32_t ids[2] = {};
+        CHECK(cc_allocate_ids(matrix, ranks, ids, 1) == CC_OK);
+        CHECK(ids[0] == 0);
+        CHECK(cc_allocate_ids(matrix, ranks, ids, 2) == CC_LOAD_FAILED);
+        CHECK(std::string(cc_last_error()).find("Error:") == 0);
+
+        CHECK(cc_find_college(matrix, "A", 1) == CC_NO_COLLEGE);
+        char name[4];
+        size_t length = 0;
+        CHECK(cc_college_name(matrix, 3, name, sizeof(name), &length) == CC_LOAD_FAILED);
+        size_t count = 0;
+        CHECK(cc_band(matrix, 1, 40, ids, 2, &count) == CC_LOAD_FAILED);
+        const std::int32_t* starts = nullptr;
+        const std::int32_t* segmentIds = nullptr;
+        CHECK(cc_segments(matrix, &starts, &segmentIds, &count) == CC_LOAD_FAILED);
+        cc_seat_matrix_close(matrix);
+    }
+}
+
+int main() {
+    testQueries();
+    testCorruptSectionIsReported();
+    std::remove(snapshotPath.c_str());
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <exception>
+#include <iostream>
+
+// Minimal assertions for the test executables: a failed CHECK is reported and counted, and
+// main returns the count so CTest sees the failure
+namespace CollegeCounselingTests {
+    inline int& failureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void reportFailure(const char* file, int line, const char* expression) {
+        std::cerr << file << ":" << line << ": CHECK failed: " << expression << std::endl;
+        ++failureCount();
+    }
+}
+
+#define CHECK(expression)                                                                  \
+    do {                                                                                   \
+        if (!(expression)) {                                                               \
+            CollegeCounselingTests::reportFailure(__FILE__, __LINE__, #expression);        \
+        }                                                                                  \
+    } while (false)
+
+// Checks that a statement throws std::exception
+#define CHECK_THROWS(statement)                                                            \
+    do {                                                                                   \
+        bool thrown = false;                                                               \
+        try {                                                                              \
+            statement;                                                                     \
+        } catch (const std::exception&) {                                                  \
+            thrown = true;                                                                 \
+        }                                                                                  \
+        if (!thrown) {                                                                     \
+            CollegeCounselingTests::reportFailure(__FILE__, __LINE__, "throws: " #statement); \
+        }                                                                                  \
+    } while (false)
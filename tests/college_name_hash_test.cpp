@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "CollegeCounseling/CollegeNameHash.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::CollegeNameHash;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    const std::int32_t none = AllocationStrategy::noCollegeId;
+
+    struct Lookup {
+        std::string name;
+        std::int32_t expected;
+    };
+
+    struct Case {
+        const char* description;
+        std::vector<std::string> namesById;
+        std::vector<Lookup> lookups;
+    };
+
+    std::vector<std::string_view> views(const std::vector<std::string>& names) {
+        return std::vector<std::string_view>(names.begin(), names.end());
+    }
+
+    void testCases() {
+        const Case cases[] = {
+            { "empty table", {}, { { "A", none }, { "", none } } },
+            { "single name", { "IIT Delhi" }, { { "IIT Delhi", 0 }, { "IIT", none }, { "IIT Delhi 2", none }, { "", none } } },
+            { "duplicates resolve to the first ID",
+              { "A", "B", "A", "C", "B", "A" },
+              { { "A", 0 }, { "B", 1 }, { "C", 3 }, { "D", none } } },
+            { "surrounding whitespace ignored on both sides",
+              { " NIT Trichy ", "BITS Pilani\r", "\tIIT Bombay" },
+              { { "NIT Trichy", 0 }, { "  NIT Trichy\t", 0 }, { "BITS Pilani", 1 }, { "IIT Bombay \r\n", 2 },
+                { "NIT  Trichy", none } } },
+            { "whitespace variants of one name are duplicates",
+              { "X", " Y", "Y ", "Y" },
+              { { "X", 0 }, { "Y", 1 } } },
+            { "case and punctuation are significant",
+              { "IIT Delhi", "IIT, Delhi" },
+              { { "iit delhi", none }, { "IIT Delhi", 0 }, { "IIT, Delhi", 1 }, { "IIT Delhi,", none } } },
+            { "prefixes and extensions of keys are not keys",
+              { "College", "College of Engineering", "Engineering" },
+              { { "College", 0 }, { "College of Engineering", 1 }, { "Engineering", 2 }, { "College of", none },
+                { "College of Engineeri", none }, { "College of Engineering Pune", none } } },
+        };
+        for (const Case& test : cases) {
+            CollegeNameHash hash;
+            hash.build(views(test.namesById));
+            size_t wrong = 0;
+            for (const Lookup& lookup : test.lookups) {
+                wrong += hash.find(lookup.name) != lookup.expected ? 1 : 0;
+            }
+            if (wrong != 0) {
+                std::printf("case: %s\n", test.description);
+            }
+            CHECK(wrong == 0);
+        }
+    }
+
+    // Many names, a third of them repeated: every key is found at its first ID, and names that
+    // differ from a key by one character or were never added are rejected
+    void testLargeTable() {
+        std::mt19937 random(60);
+        std::vector<std::string> names;
+        std::unordered_map<std::string, std::int32_t> firstIds;
+        for (int id = 0; id < 60000; ++id) {
+            std::string name = id % 3 == 2 && id > 0 ? names[std::uniform_int_distribution<size_t>(0, names.size() - 1)(random)]
+                                                    : "College " + std::to_string(random() % 1000000) + ", City " + std::to_string(id % 97);
+            names.push_back(name);
+            firstIds.emplace(name, id);
+        }
+        CollegeNameHash hash;
+        hash.build(views(names));
+
+        size_t wrongKeys = 0;
+        size_t acceptedNonKeys = 0;
+        for (const auto& entry : firstIds) {
+            wrongKeys += hash.find(entry.first) != entry.second ? 1 : 0;
+            std::string altered = entry.first;
+            altered[altered.size() / 2] = static_cast<char>(altered[altered.size() / 2] ^ 0x20);
+            if (!firstIds.count(altered)) {
+                acceptedNonKeys += hash.find(altered) != none ? 1 : 0;
+            }
+            std::string unknown = "Unknown " + entry.first;
+            acceptedNonKeys += hash.find(unknown) != none ? 1 : 0;
+        }
+        CHECK(wrongKeys == 0);
+        CHECK(acceptedNonKeys == 0);
+        CHECK(hash.getMemoryBytes() > 0);
+
+        // Rebuilding over a different set forgets the old one
+        std::vector<std::string> other = { "Only" };
+        hash.build(views(other));
+        CHECK(hash.find("Only") == 0);
+        CHECK(hash.find(names[0]) == none);
+    }
+
+    // The table and its sectioned snapshot resolve names through the hash the same way
+    void testThroughTable() {
+        std::ostringstream text;
+        for (int id = 0; id < 300; ++id) {
+            text << id * 10 << "-" << id * 10 + 9 << ": College " << id % 120 << "\n";
+        }
+        RankIntervalStrategy table(MappedFile::fromString(text.str()));
+        std::ostringstream sectioned;
+        table.writeSectioned(sectioned, 32);
+        RankIntervalStrategy paged(MappedFile::fromString(sectioned.str()));
+        size_t wrong = 0;
+        for (int college = 0; college < 120; ++college) {
+            std::string name = "College " + std::to_string(college);
+            wrong += table.findCollegeId(name) != college ? 1 : 0;
+            wrong += paged.findCollegeId(" " + name + " ") != college ? 1 : 0;
+        }
+        CHECK(wrong == 0);
+        CHECK(table.findCollegeId("College 120") == none);
+        CHECK(paged.findCollegeId("College 120") == none);
+    }
+}
+
+int main() {
+    testCases();
+    testLargeTable();
+    testThroughTable();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,144 @@
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/CollegeSearchIndex.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::CollegeSearchIndex;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    RankIntervalStrategy tableOf(const std::vector<std::string>& names) {
+        std::string text;
+        for (size_t id = 0; id < names.size(); ++id) {
+            text += std::to_string(id * 10) + "-" + std::to_string(id * 10 + 9) + ":" + names[id] + "\n";
+        }
+        return RankIntervalStrategy(MappedFile::fromString(text));
+    }
+
+    struct Query {
+        const char* description;
+        std::string text;
+        std::string city;
+        std::vector<std::int32_t> expected;
+    };
+
+    void testQueries() {
+        const std::vector<std::string> names = {
+            "Indian Institute of Technology, Delhi",
+            "Indian Institute of Technology, Bombay",
+            "National Institute of Technology, Trichy",
+            "Delhi Technological University, Delhi",
+            "IIIT-Hyderabad, Hyderabad",
+            "St. Xavier's College, Mumbai",
+            "Aaa Aaaa Academy, Pune",
+        };
+        RankIntervalStrategy table = tableOf(names);
+        CollegeSearchIndex index(table);
+
+        const Query queries[] = {
+            { "empty query matches every college", "", "", { 0, 1, 2, 3, 4, 5, 6 } },
+            { "one character is a substring scan", "y", "", { 0, 1, 2, 3, 4, 6 } },
+            { "two characters are a substring scan", "xa", "", { 5 } },
+            { "two characters with no match", "qz", "", {} },
+            { "punctuation only normalizes to empty", "--", "", { 0, 1, 2, 3, 4, 5, 6 } },
+            { "short query within a city", "iit", "Hyderabad", { 4 } },
+            { "one trigram", "iit", "", { 4 } },
+            { "case insensitive", "TECHNOLOG", "", { 0, 1, 2, 3 } },
+            { "all trigrams must be present", "institute of technology", "", { 0, 1, 2 } },
+            { "trigrams present but not adjacent", "technology delhi", "", { 0 } },
+            { "trigrams of both words but not the phrase", "delhi technology", "", {} },
+            { "unknown trigram ends the search", "xyzzy", "", {} },
+            { "punctuation and spacing normalized", "st  xavier s", "", { 5 } },
+            { "hyphen becomes a space", "iiit hyderabad", "", { 4 } },
+            { "repeated trigrams", "aaa aaaa", "", { 6 } },
+            { "city facet filters matches", "technology", "delhi", { 0 } },
+            { "city facet is normalized", "institute", "  BOMBAY ", { 1 } },
+            { "name text outside the city facet", "delhi", "", { 0, 3 } },
+            { "unknown city", "institute", "Chennai", {} },
+        };
+        for (const Query& query : queries) {
+            bool matches = index.search(query.text, query.city) == query.expected;
+            if (!matches) {
+                std::printf("query: %s\n", query.description);
+            }
+            CHECK(matches);
+        }
+        CHECK(index.findByCity("Delhi") == std::vector<std::int32_t>({ 0, 3 }));
+        CHECK(index.findByCity("Kolkata").empty());
+    }
+
+    // The search's own normalization: lowercase letters and digits, other runs become one space
+    std::string normalized(const std::string& text) {
+        std::string result;
+        bool pendingSpace = false;
+        for (unsigned char c : text) {
+            if (std::isalnum(c)) {
+                if (pendingSpace && !result.empty()) {
+                    result.push_back(' ');
+                }
+                result.push_back(static_cast<char>(std::tolower(c)));
+                pendingSpace = false;
+            } else {
+                pendingSpace = true;
+            }
+        }
+        return result;
+    }
+
+    // Names over a small alphabet, so trigram postings are long and deltas need several varint
+    // bytes; every query is checked against a substring scan
+    void testAgainstScan() {
+        std::mt19937 random(59);
+        const char alphabet[] = "abcAB -";
+        std::uniform_int_distribution<int> letter(0, 6);
+        std::vector<std::string> names;
+        for (int id = 0; id < 3000; ++id) {
+            std::string name = id % 500 == 0 ? "Rare Name" : "";
+            int length = std::uniform_int_distribution<int>(3, 14)(random);
+            for (int i = 0; i < length; ++i) {
+                name.push_back(alphabet[letter(random)]);
+            }
+            names.push_back(name + ", City" + std::to_string(id % 5));
+        }
+        RankIntervalStrategy table = tableOf(names);
+        CollegeSearchIndex index(table);
+
+        size_t mismatches = 0;
+        std::vector<std::string> queries = { "rare name", "rare", "city3", "ab", "a", "" };
+        for (int q = 0; q < 300; ++q) {
+            std::string query;
+            int length = std::uniform_int_distribution<int>(1, 7)(random);
+            for (int i = 0; i < length; ++i) {
+                query.push_back(alphabet[letter(random)]);
+            }
+            queries.push_back(query);
+        }
+        for (const std::string& query : queries) {
+            for (const std::string& city : { std::string(), std::string("City3") }) {
+                std::vector<std::int32_t> expected;
+                std::string needle = normalized(query);
+                for (size_t id = 0; id < names.size(); ++id) {
+                    bool inCity = city.empty() || id % 5 == 3;
+                    if (inCity && normalized(table.getCollegeName(static_cast<int>(id))).find(needle) != std::string::npos) {
+                        expected.push_back(static_cast<std::int32_t>(id));
+                    }
+                }
+                mismatches += index.search(query, city) != expected ? 1 : 0;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+int main() {
+    testQueries();
+    testAgainstScan();
+    return CollegeCounselingTests::failureCount();
+}
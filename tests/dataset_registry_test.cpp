@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/DatasetRegistry.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::CollegeNamePool;
+using CollegeCounseling::DatasetIndex;
+using CollegeCounseling::DatasetKey;
+using CollegeCounseling::DatasetRegistry;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    // Seat matrix of 200 colleges of ten ranks each, starting at firstRank; every year uses the
+    // same college names
+    std::string writeSeatMatrix(const std::string& path, int firstRank) {
+        std::ofstream output(path, std::ios::binary);
+        for (int id = 0; id < 200; ++id) {
+            int start = firstRank + id * 10;
+            output << start << "-" << start + 9 << ":College " << id << "\n";
+        }
+        return path;
+    }
+
+    DatasetKey year(int y) {
+        return { "JEE", y, 1 };
+    }
+
+    std::vector<bool> loadedYears(const DatasetRegistry& registry) {
+        std::vector<bool> loaded;
+        for (int y = 2020; y < 2025; ++y) {
+            loaded.push_back(registry.isLoaded(year(y)));
+        }
+        return loaded;
+    }
+
+    // Datasets of equal size under a budget holding three of them: a load past the budget
+    // drops the least recently used one, and a query refreshes a dataset's position
+    void testEvictionOrder() {
+        std::vector<std::string> paths;
+        for (int y = 2020; y < 2025; ++y) {
+            paths.push_back(writeSeatMatrix("dataset_registry_test_" + std::to_string(y) + ".txt", (y - 2019) * 1000));
+        }
+        // Measured under a budget too small for a dense table, as in the registry below
+        size_t datasetBytes;
+        {
+            DatasetRegistry measuring(1);
+            measuring.add(year(2020), paths[0]);
+            measuring.get(year(2020));
+            datasetBytes = measuring.getResidentBytes();
+        }
+        CHECK(datasetBytes > 0);
+
+        DatasetRegistry registry(datasetBytes * 3 + datasetBytes / 2);
+        for (int y = 2020; y < 2025; ++y) {
+            registry.add(year(y), paths[static_cast<size_t>(y - 2020)]);
+        }
+        CHECK_THROWS(registry.add(year(2020), paths[0]));
+        CHECK(registry.getLoadedCount() == 0);
+
+        CHECK(registry.allocateCollegeId(year(2020), 1005) == 0);
+        CHECK(registry.allocateCollegeId(year(2021), 2015) == 1);
+        CHECK(registry.allocateCollegeId(year(2022), 3025) == 2);
+        CHECK(loadedYears(registry) == std::vector<bool>({ true, true, true, false, false }));
+        CHECK(registry.getResidentBytes() == datasetBytes * 3);
+
+        // 2020 is used again, so 2021 is now the oldest and goes first
+        std::shared_ptr<const AllocationStrategy> held = registry.get(year(2021));
+        registry.get(year(2020));
+        registry.get(year(2022));
+        registry.get(year(2020));
+        CHECK(registry.allocateCollegeId(year(2023), 4000) == 0);
+        CHECK(loadedYears(registry) == std::vector<bool>({ true, false, true, true, false }));
+        CHECK(registry.allocateCollegeId(year(2024), 5000) == 0);
+        CHECK(loadedYears(registry) == std::vector<bool>({ true, false, false, true, true }));
+        CHECK(registry.getLoadedCount() == 3);
+        CHECK(registry.getResidentBytes() == datasetBytes * 3);
+
+        // An evicted dataset stays usable through a held pointer, and reloads on its next query
+        CHECK(held->allocateCollegeId(2015) == 1);
+        CHECK(registry.allocateCollegeId(year(2021), 2995) == 99);
+        CHECK(loadedYears(registry) == std::vector<bool>({ false, true, false, true, true }));
+
+        // A budget smaller than one dataset still keeps the newest
+        DatasetRegistry tiny(1);
+        tiny.add(year(2020), paths[0]);
+        tiny.add(year(2021), paths[1]);
+        tiny.get(year(2020));
+        tiny.get(year(2021));
+        CHECK(tiny.getLoadedCount() == 1);
+        CHECK(tiny.isLoaded(year(2021)));
+        CHECK_THROWS(tiny.get(year(2030)));
+
+        for (const std::string& path : paths) {
+            std::remove(path.c_str());
+        }
+    }
+
+    // Every year interns its names into the registry's pool: the names are stored once, and
+    // stay there after the datasets holding them are evicted
+    void testSharedNamePool() {
+        std::string first = writeSeatMatrix("dataset_registry_test_a.txt", 1000);
+        std::string second = writeSeatMatrix("dataset_registry_test_b.txt", 7000);
+        auto pool = std::make_shared<CollegeNamePool>();
+        for (DatasetIndex kind : { DatasetIndex::Plain, DatasetIndex::Compressed }) {
+            DatasetRegistry registry(1, kind, pool);
+            registry.add(year(2020), first);
+            registry.add(year(2021), second);
+            std::shared_ptr<const AllocationStrategy> a = registry.get(year(2020));
+            std::shared_ptr<const AllocationStrategy> b = registry.get(year(2021));
+            CHECK(&registry.getNamePool() == pool.get());
+            CHECK(pool->getNameCount() == 200);
+            CHECK(a->allocateCollege(1005) == "College 0");
+            CHECK(b->allocateCollege(8995) == "College 199");
+            CHECK(a->allocateCollegeId(900) == AllocationStrategy::noCollegeId);
+            if (kind == DatasetIndex::Plain) {
+                auto tableA = std::dynamic_pointer_cast<const RankIntervalStrategy>(a);
+                auto tableB = std::dynamic_pointer_cast<const RankIntervalStrategy>(b);
+                CHECK(tableA && tableB && &tableA->getCollegeName(42) == &tableB->getCollegeName(42));
+            }
+            CHECK(!registry.isLoaded(year(2020)));
+        }
+        CHECK(pool->getNameCount() == 200);
+        std::remove(first.c_str());
+        std::remove(second.c_str());
+    }
+
+    // A plain dataset gets a dense table only if it fits in its share of the budget; either way
+    // it answers the same
+    void testDenseTableWithinBudget() {
+        const int domain = 1 << 20;
+        std::string path = "dataset_registry_test_dense.txt";
+        {
+            std::ofstream output(path, std::ios::binary);
+            output << "0-" << domain / 2 << ":Wide\n" << domain / 2 + 1 << "-" << domain << ":Other\n";
+        }
+        DatasetRegistry small(size_t(8) << 20);
+        DatasetRegistry large(size_t(256) << 20);
+        DatasetRegistry compressed(size_t(8) << 20, DatasetIndex::Compressed);
+        for (DatasetRegistry* registry : { &small, &large, &compressed }) {
+            registry->add(year(2020), path);
+            registry->get(year(2020));
+        }
+        CHECK(small.getResidentBytes() <= (size_t(8) << 20) / DatasetRegistry::denseBudgetShare);
+        CHECK(large.getResidentBytes() >= domain * sizeof(std::int32_t));
+        CHECK(compressed.getResidentBytes() <= (size_t(8) << 20) / DatasetRegistry::denseBudgetShare);
+        for (int rank : { -1, 0, domain / 2, domain / 2 + 1, domain, domain + 1 }) {
+            int expected = rank < 0 || rank > domain ? AllocationStrategy::noCollegeId : rank <= domain / 2 ? 0 : 1;
+            CHECK(small.allocateCollegeId(year(2020), rank) == expected);
+            CHECK(large.allocateCollegeId(year(2020), rank) == expected);
+            CHECK(compressed.allocateCollegeId(year(2020), rank) == expected);
+        }
+        std::remove(path.c_str());
+    }
+}
+
+int main() {
+    testEvictionOrder();
+    testSharedNamePool();
+    testDenseTableWithinBudget();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "CollegeCounseling/DynamicIntervalIndex.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::DynamicIntervalIndex;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+using CollegeCounseling::SeatMatrixSnapshot;
+
+namespace {
+    RankIntervalStrategy baseTable() {
+        return RankIntervalStrategy(MappedFile::fromString("1-10:A\n11-20:B\n21-30:C\n"));
+    }
+
+    // Each edit is visible to the next query, and a snapshot taken before it is not affected
+    void testEditsArePublished() {
+        RankIntervalStrategy table = baseTable();
+        DynamicIntervalIndex index(table);
+        SeatMatrixSnapshot before = index.snapshot();
+
+        int added = index.addInterval(31, 40, "D");
+        CHECK(added == 3);
+        CHECK(index.allocateCollegeId(35) == 3);
+        CHECK(index.allocateCollege(35) == "D");
+
+        index.removeInterval(1);
+        CHECK(index.allocateCollegeId(15) == AllocationStrategy::noCollegeId);
+        CHECK(index.getCollegeName(1) == "B");
+
+        index.resizeInterval(2, 15, 25);
+        CHECK(index.allocateCollegeId(15) == 2);
+        CHECK(index.allocateCollegeId(28) == AllocationStrategy::noCollegeId);
+        CHECK(index.getRankInterval(2) == std::make_pair(15, 25));
+
+        CHECK(index.getEditCount() == 3);
+        CHECK(index.getCollegeCount() == 4);
+        CHECK(index.getIntervalCount() == 3);
+
+        // The pre-edit snapshot still answers like the original table
+        CHECK(before.getCollegeCount() == 3);
+        for (int rank = 0; rank <= 45; ++rank) {
+            CHECK(before.allocateCollegeId(rank) == table.allocateCollegeId(rank));
+        }
+        CHECK_THROWS(index.removeInterval(9));
+        CHECK_THROWS(index.resizeInterval(0, 5, 1));
+        CHECK(index.getEditCount() == 3);
+    }
+
+    void testCorrectionsFile() {
+        DynamicIntervalIndex index(baseTable());
+        std::istringstream corrections("// round 2 corrections\r\n"
+                                       "+ 31-40: New College \r\n"
+                                       "\n"
+                                       "- 0\n"
+                                       "  = 1 1-20\n");
+        CHECK(CollegeCounseling::applySeatCorrections(index, corrections) == 3);
+        CHECK(index.getCollegeName(3) == "New College");
+        CHECK(index.allocateCollegeId(35) == 3);
+        CHECK(index.allocateCollegeId(5) == 1);
+        CHECK(index.allocateCollegeId(25) == 2);
+
+        std::istringstream missingName("+ 41-50:\n");
+        CHECK_THROWS(CollegeCounseling::applySeatCorrections(index, missingName));
+        std::istringstream badLine("= 1 20\n");
+        CHECK_THROWS(CollegeCounseling::applySeatCorrections(index, badLine));
+        std::istringstream unknownId("- 17\n");
+        CHECK_THROWS(CollegeCounseling::applySeatCorrections(index, unknownId));
+    }
+
+    // Readers running batches while a writer moves college 2 back and forth between [21, 30]
+    // and [31, 40]: each batch comes from one snapshot, so exactly one of ranks 25 and 35 maps
+    // to it, never both or neither
+    void testReadersDuringEdits() {
+        DynamicIntervalIndex index(baseTable());
+        std::atomic<bool> done{ false };
+        std::atomic<int> torn{ 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                std::int32_t ranks[2] = { 25, 35 };
+                std::int32_t ids[2];
+                while (!done.load()) {
+                    index.allocateCollegeIds(ranks, ids, 2);
+                    if ((ids[0] == 2) == (ids[1] == 2)) {
+                        ++torn;
+                    }
+                }
+            });
+        }
+        for (int edit = 0; edit < 5000; ++edit) {
+            SeatMatrixSnapshot held = index.snapshot();
+            bool moveUp = edit % 2 == 0;
+            index.resizeInterval(2, moveUp ? 31 : 21, moveUp ? 40 : 30);
+            // A snapshot held across the edit keeps its answers
+            CHECK(held.allocateCollegeId(moveUp ? 25 : 35) == 2);
+            CHECK(index.allocateCollegeId(moveUp ? 35 : 25) == 2);
+        }
+        done = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        CHECK(torn.load() == 0);
+        CHECK(index.getEditCount() == 5000);
+    }
+}
+
+int main() {
+    testEditsArePublished();
+    testCorrectionsFile();
+    testReadersDuringEdits();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/CompressedIntervalIndex.h"
+#include "CollegeCounseling/EliasFano.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::CompressedIntervalIndex;
+using CollegeCounseling::EliasFanoSequence;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::PackedIntArray;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    // Checks access to every value and countAtMost on each value, its neighbours and past the end
+    bool matches(const std::vector<std::uint64_t>& values) {
+        EliasFanoSequence sequence;
+        sequence.build(values);
+        if (sequence.size() != values.size()) {
+            return false;
+        }
+        std::vector<std::uint64_t> probes = { 0, 1, 2, 63, 64, 65 };
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (sequence[i] != values[i]) {
+                return false;
+            }
+            probes.push_back(values[i]);
+            probes.push_back(values[i] + 1);
+            if (values[i] > 0) {
+                probes.push_back(values[i] - 1);
+            }
+        }
+        std::uint64_t last = values.empty() ? 0 : values.back();
+        probes.push_back(last * 2 + 1000);
+        for (std::uint64_t x : probes) {
+            size_t expected = static_cast<size_t>(std::upper_bound(values.begin(), values.end(), x) - values.begin());
+            if (sequence.countAtMost(x) != expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void testEdgeCases() {
+        CHECK(matches({}));
+        CHECK(matches({ 0 }));
+        CHECK(matches({ 5 }));
+        CHECK(matches({ 1u << 30 }));
+        CHECK(matches(std::vector<std::uint64_t>(1000, 7)));
+        CHECK(matches(std::vector<std::uint64_t>(1000, 0)));
+        CHECK(matches({ 0, 0, 1, 1, 1 << 20, 1 << 20 }));
+
+        // 256 values below 4096 get 4 low bits: values on and either side of multiples of 16
+        // put neighbours in adjacent high buckets, with empty buckets in between
+        std::vector<std::uint64_t> boundary;
+        for (std::uint64_t v = 16; v < 4080; v += 16) {
+            boundary.push_back(v - 1);
+            boundary.push_back(v);
+        }
+        CHECK(matches(boundary));
+
+        // Long runs of ones and zeros in the upper bits cross several select samples
+        std::vector<std::uint64_t> clustered(300, 3);
+        clustered.resize(600, 1 << 16);
+        CHECK(matches(clustered));
+
+        CHECK_THROWS(EliasFanoSequence().build({ 3, 2 }));
+    }
+
+    void testRandomSequences() {
+        std::mt19937_64 random(75);
+        const std::uint64_t universes[] = { 2, 100, 1 << 16, std::uint64_t(1) << 31 };
+        for (std::uint64_t universe : universes) {
+            for (size_t count : { size_t(1), size_t(2), size_t(63), size_t(64), size_t(65), size_t(1000), size_t(5000) }) {
+                std::vector<std::uint64_t> values(count);
+                for (std::uint64_t& value : values) {
+                    value = std::uniform_int_distribution<std::uint64_t>(0, universe - 1)(random);
+                }
+                std::sort(values.begin(), values.end());
+                CHECK(matches(values));
+            }
+        }
+    }
+
+    void testPackedWidths() {
+        std::mt19937_64 random(7);
+        for (int width = 0; width <= 64; ++width) {
+            std::vector<std::uint64_t> values(200);
+            PackedIntArray packed(values.size(), width);
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = width == 0 ? 0 : random() >> (64 - width);
+                packed.set(i, values[i]);
+            }
+            bool same = true;
+            for (size_t i = 0; i < values.size(); ++i) {
+                same = same && packed.get(i) == values[i];
+            }
+            CHECK(same);
+        }
+        CHECK(PackedIntArray::bitsFor(0) == 0);
+        CHECK(PackedIntArray::bitsFor(1) == 1);
+        CHECK(PackedIntArray::bitsFor(255) == 8);
+        CHECK(PackedIntArray::bitsFor(256) == 9);
+    }
+
+    // Random overlapping tables, including empty rows: the compressed index must answer every
+    // rank like the table it was built from
+    void testCompressedAgainstTable() {
+        std::mt19937 random(750);
+        for (int round = 0; round < 30; ++round) {
+            int count = std::uniform_int_distribution<int>(0, round < 5 ? 3 : 2000)(random);
+            int domain = round % 3 == 0 ? 500 : 5000000;
+            std::string text;
+            for (int id = 0; id < count; ++id) {
+                int start = std::uniform_int_distribution<int>(0, domain)(random);
+                int end = id % 11 == 3 ? start - 1 : start + std::uniform_int_distribution<int>(0, domain / 50)(random);
+                text += std::to_string(start) + "-" + std::to_string(end) + ":C" + std::to_string(id) + "\n";
+            }
+            RankIntervalStrategy table(MappedFile::fromString(text));
+            CompressedIntervalIndex compressed(table);
+            CHECK(compressed.getCollegeCount() == table.getCollegeCount());
+            CHECK(compressed.getSegmentCount() == table.getSegmentStarts().size());
+            size_t mismatches = 0;
+            for (size_t k = 0; k < table.getSegmentStarts().size(); ++k) {
+                int start = table.getSegmentStarts()[k];
+                for (int rank : { start - 1, start, start + 1 }) {
+                    mismatches += compressed.allocateCollegeId(rank) != table.allocateCollegeId(rank) ? 1 : 0;
+                }
+            }
+            for (int i = 0; i < 2000; ++i) {
+                int rank = std::uniform_int_distribution<int>(-10, domain * 2)(random);
+                mismatches += compressed.allocateCollegeId(rank) != table.allocateCollegeId(rank) ? 1 : 0;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+}
+
+int main() {
+    testEdgeCases();
+    testRandomSequences();
+    testPackedWidths();
+    testCompressedAgainstTable();
+    return CollegeCounselingTests::failureCount();
+}
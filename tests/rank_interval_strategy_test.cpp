@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+
+namespace {
+    struct Interval {
+        int rankStart;
+        int rankEnd;
+    };
+
+    // Table text for the intervals, named by ID
+    std::string tableText(const std::vector<Interval>& intervals) {
+        std::string text;
+        for (size_t id = 0; id < intervals.size(); ++id) {
+            text += std::to_string(intervals[id].rankStart) + "-" + std::to_string(intervals[id].rankEnd) + ":C" + std::to_string(id) + "\n";
+        }
+        return text;
+    }
+
+    RankIntervalStrategy sectioned(const RankIntervalStrategy& table, size_t rowsPerSection) {
+        std::ostringstream out;
+        table.writeSectioned(out, rowsPerSection);
+        return RankIntervalStrategy(MappedFile::fromString(out.str()));
+    }
+
+    // IDs overlapping the band in (rankStart, ID) order, by brute force; a reversed band is empty
+    std::vector<int> expectedBand(const std::vector<Interval>& intervals, int firstRank, int lastRank) {
+        std::vector<int> ids;
+        if (firstRank > lastRank) {
+            return ids;
+        }
+        for (size_t id = 0; id < intervals.size(); ++id) {
+            if (intervals[id].rankStart <= intervals[id].rankEnd && intervals[id].rankStart <= lastRank && intervals[id].rankEnd >= firstRank) {
+                ids.push_back(static_cast<int>(id));
+            }
+        }
+        std::stable_sort(ids.begin(), ids.end(), [&](int a, int b) { return intervals[a].rankStart < intervals[b].rankStart; });
+        return ids;
+    }
+
+    std::vector<int> scannedBand(const RankIntervalStrategy& table, int firstRank, int lastRank) {
+        std::vector<int> ids;
+        for (const RankIntervalStrategy::BandInterval& interval : table.scanBand(firstRank, lastRank)) {
+            ids.push_back(interval.collegeId);
+        }
+        return ids;
+    }
+
+    // Deeply nested tables: long intervals enclosing many short ones, the case the max-end
+    // tree exists for, plus empty rows and bands outside the table
+    void testBandsAgainstBruteForce() {
+        std::mt19937 random(73);
+        for (int round = 0; round < 20; ++round) {
+            std::vector<Interval> intervals;
+            int count = std::uniform_int_distribution<int>(1, 400)(random);
+            for (int id = 0; id < count; ++id) {
+                int start = std::uniform_int_distribution<int>(0, 10000)(random);
+                int length = id % 10 == 0 ? std::uniform_int_distribution<int>(0, 8000)(random)
+                                          : std::uniform_int_distribution<int>(0, 30)(random);
+                intervals.push_back(id % 17 == 5 ? Interval{ 1, 0 } : Interval{ start, start + length });
+            }
+            RankIntervalStrategy table(MappedFile::fromString(tableText(intervals)));
+            RankIntervalStrategy paged = sectioned(table, 16);
+            for (int query = 0; query < 60; ++query) {
+                int firstRank = std::uniform_int_distribution<int>(-100, 19000)(random);
+                int lastRank = firstRank + std::uniform_int_distribution<int>(-5, 300)(random);
+                std::vector<int> expected = expectedBand(intervals, firstRank, lastRank);
+                CHECK(scannedBand(table, firstRank, lastRank) == expected);
+                CHECK(scannedBand(paged, firstRank, lastRank) == expected);
+            }
+        }
+    }
+
+    // A band over a sectioned snapshot loads only the sections whose rank range overlaps it
+    void testSectionedBandLoadsOverlappingSections() {
+        std::vector<Interval> intervals;
+        for (int id = 0; id < 100; ++id) {
+            intervals.push_back({ id * 100, id * 100 + 99 });
+        }
+        RankIntervalStrategy table(MappedFile::fromString(tableText(intervals)));
+        RankIntervalStrategy paged = sectioned(table, 10);
+        CHECK(paged.getSectionCount() == 10);
+        CHECK(scannedBand(paged, 2550, 2620) == std::vector<int>({ 25, 26 }));
+        CHECK(paged.getLoadedSectionCount() == 1);
+        CHECK(scannedBand(paged, 2950, 3050) == std::vector<int>({ 29, 30 }));
+        CHECK(paged.getLoadedSectionCount() == 2);
+        CHECK(scannedBand(paged, 20000, 30000).empty());
+        CHECK(paged.getLoadedSectionCount() == 2);
+    }
+
+    // Sparse table of disjoint intervals spaced out over spacing * count ranks, with a
+    // reference map from start to (end, ID)
+    std::vector<Interval> sparseTable(std::mt19937& random, int count, int spacing, std::map<int, std::pair<int, int>>& reference) {
+        std::vector<Interval> intervals;
+        for (int id = 0; id < count; ++id) {
+            int start = id * spacing + std::uniform_int_distribution<int>(0, spacing / 2)(random);
+            int end = start + std::uniform_int_distribution<int>(0, spacing / 4)(random);
+            intervals.push_back({ start, end });
+            reference[start] = { end, id };
+        }
+        return intervals;
+    }
+
+    int referenceLookup(const std::map<int, std::pair<int, int>>& reference, int rank) {
+        auto next = reference.upper_bound(rank);
+        if (next == reference.begin()) {
+            return AllocationStrategy::noCollegeId;
+        }
+        --next;
+        return rank <= next->second.first ? next->second.second : AllocationStrategy::noCollegeId;
+    }
+
+    // Wide sparse domains with enough segments get the coverage filter: exact up to 2^27 ranks,
+    // per block beyond. Single and batch lookups must match the reference on hits, on misses
+    // between intervals and on the ranks either side of every boundary.
+    void testCoverageFilter() {
+        std::mt19937 random(74);
+        const int spacings[] = { 1700, 1700 * 50 };
+        for (int spacing : spacings) {
+            std::map<int, std::pair<int, int>> reference;
+            std::vector<Interval> intervals = sparseTable(random, 20000, spacing, reference);
+            RankIntervalStrategy table(MappedFile::fromString(tableText(intervals)));
+            CHECK(table.getCoverage().isBuilt());
+            CHECK(table.getCoverage().isExact() == (spacing == 1700));
+
+            std::vector<std::int32_t> ranks;
+            for (const Interval& interval : intervals) {
+                ranks.push_back(interval.rankStart - 1);
+                ranks.push_back(interval.rankStart);
+                ranks.push_back(interval.rankEnd);
+                ranks.push_back(interval.rankEnd + 1);
+            }
+            for (int i = 0; i < 50000; ++i) {
+                ranks.push_back(std::uniform_int_distribution<int>(-1000, 20000 * spacing + 1000)(random));
+            }
+            std::vector<std::int32_t> batch(ranks.size());
+            table.allocateCollegeIds(ranks.data(), batch.data(), ranks.size());
+            size_t singleMismatches = 0;
+            size_t batchMismatches = 0;
+            size_t falseRejections = 0;
+            size_t misses = 0;
+            for (size_t i = 0; i < ranks.size(); ++i) {
+                int expected = referenceLookup(reference, ranks[i]);
+                singleMismatches += table.allocateCollegeId(ranks[i]) != expected ? 1 : 0;
+                batchMismatches += batch[i] != expected ? 1 : 0;
+                bool passed = table.getCoverage().mayCover(ranks[i]);
+                falseRejections += expected != AllocationStrategy::noCollegeId && !passed ? 1 : 0;
+                // An exact filter rejects every miss
+                if (table.getCoverage().isExact() && expected == AllocationStrategy::noCollegeId && passed) {
+                    ++misses;
+                }
+            }
+            CHECK(singleMismatches == 0);
+            CHECK(batchMismatches == 0);
+            CHECK(falseRejections == 0);
+            CHECK(misses == 0);
+        }
+
+        // A wide domain with few segments searches without a filter
+        std::map<int, std::pair<int, int>> reference;
+        RankIntervalStrategy small(MappedFile::fromString(tableText(sparseTable(random, 100, 1 << 20, reference))));
+        CHECK(!small.getCoverage().isBuilt());
+        for (int i = 0; i < 1000; ++i) {
+            int rank = std::uniform_int_distribution<int>(0, 100 << 20)(random);
+            CHECK(small.allocateCollegeId(rank) == referenceLookup(reference, rank));
+        }
+    }
+}
+
+int main() {
+    testBandsAgainstBruteForce();
+    testSectionedBandLoadsOverlappingSections();
+    testCoverageFilter();
+    return CollegeCounselingTests::failureCount();
+}
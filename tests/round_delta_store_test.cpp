@@ -0,0 +1,198 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/RoundDeltaStore.h"
+#include "check.h"
+
+using CollegeCounseling::RoundDeltaStore;
+
+namespace {
+    const std::string storePath = "round_delta_store_test.bin";
+
+    std::string readBytes(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::string& bytes) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output << bytes;
+    }
+
+    std::uint64_t readWord(const std::string& bytes, size_t offset) {
+        std::uint64_t value;
+        std::memcpy(&value, bytes.data() + offset, 8);
+        return value;
+    }
+
+    void writeWord(std::string& bytes, size_t offset, std::uint64_t value) {
+        std::memcpy(&bytes[offset], &value, 8);
+    }
+
+    // Rounds where a few applicants move each time, with IDs of one to five varint bytes and
+    // applicants left without a college
+    std::vector<std::vector<std::int32_t>> randomRounds(std::mt19937& random, size_t applicants, size_t rounds) {
+        const std::int32_t ids[] = { -1, 0, 1, 126, 127, 128, 16383, 16384, 1 << 21, (1 << 28) + 5, 2147483646 };
+        std::uniform_int_distribution<size_t> pickId(0, std::size(ids) - 1);
+        std::vector<std::vector<std::int32_t>> results;
+        std::vector<std::int32_t> current(applicants);
+        for (std::int32_t& collegeId : current) {
+            collegeId = ids[pickId(random)];
+        }
+        for (size_t r = 0; r < rounds; ++r) {
+            size_t moves = r % 5 == 3 ? 0 : std::uniform_int_distribution<size_t>(1, applicants / 4 + 1)(random);
+            for (size_t m = 0; m < moves && applicants > 0; ++m) {
+                current[std::uniform_int_distribution<size_t>(0, applicants - 1)(random)] = ids[pickId(random)];
+            }
+            results.push_back(current);
+        }
+        return results;
+    }
+
+    bool materializesAll(const RoundDeltaStore& store, const std::vector<std::vector<std::int32_t>>& results) {
+        if (store.getRoundCount() != results.size()) {
+            return false;
+        }
+        for (size_t r = 0; r < results.size(); ++r) {
+            if (store.materialize(r) != results[r]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every round reads back the same across keyframe intervals and applicant counts on and
+    // off a bitmap word boundary, before and after a save/load, and a loaded store keeps
+    // appending deltas against its last round
+    void testRoundTrip() {
+        std::mt19937 random(53);
+        for (size_t interval : { size_t(1), size_t(3), size_t(16) }) {
+            for (size_t applicants : { size_t(0), size_t(1), size_t(64), size_t(130), size_t(1000) }) {
+                std::vector<std::vector<std::int32_t>> results = randomRounds(random, applicants, 40);
+                RoundDeltaStore store(interval);
+                for (size_t r = 0; r < 30; ++r) {
+                    store.appendRound(results[r]);
+                }
+                CHECK(store.getApplicantCount() == applicants);
+                std::vector<std::vector<std::int32_t>> saved(results.begin(), results.begin() + 30);
+                CHECK(materializesAll(store, saved));
+
+                store.save(storePath);
+                RoundDeltaStore loaded = RoundDeltaStore::load(storePath);
+                CHECK(loaded.getEncodedBytes() == store.getEncodedBytes());
+                CHECK(materializesAll(loaded, saved));
+                for (size_t r = 30; r < results.size(); ++r) {
+                    loaded.appendRound(results[r]);
+                }
+                CHECK(materializesAll(loaded, results));
+            }
+        }
+
+        // Unchanged rounds cost only their bitmap
+        RoundDeltaStore steady(8);
+        std::vector<std::int32_t> result(640, 3);
+        steady.appendRound(result);
+        size_t keyframeBytes = steady.getEncodedBytes();
+        steady.appendRound(result);
+        CHECK(steady.getEncodedBytes() == keyframeBytes + 640 / 8);
+
+        CHECK_THROWS(steady.appendRound(std::vector<std::int32_t>(639, 3)));
+        CHECK_THROWS(steady.materialize(2));
+        std::remove(storePath.c_str());
+    }
+
+    // A store of 70 applicants, keyframes every 4 rounds, and the offset of round 1's bitmap
+    std::string savedStore(const std::vector<std::vector<std::int32_t>>& results, size_t& bitmapOffset) {
+        RoundDeltaStore store(4);
+        for (const std::vector<std::int32_t>& result : results) {
+            store.appendRound(result);
+        }
+        store.save(storePath);
+        std::string bytes = readBytes(storePath);
+        bitmapOffset = 32 + 8 + readWord(bytes, 32) + 8;
+        return bytes;
+    }
+
+    bool loadFails(const std::string& bytes) {
+        writeBytes(storePath, bytes);
+        try {
+            RoundDeltaStore::load(storePath);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
+    void testCorruptFilesRejected() {
+        std::mt19937 random(530);
+        std::vector<std::vector<std::int32_t>> results = randomRounds(random, 70, 2);
+        results[0][5] = 0;
+        results[0][69] = 4;
+        results[1] = results[0];
+        results[1][5] = 1 << 21;
+        results[1][69] = -1;
+        size_t bitmapOffset;
+        const std::string bytes = savedStore(results, bitmapOffset);
+        CHECK(!loadFails(bytes));
+
+        // Every truncation, including an empty file and a lone header
+        size_t truncations = 0;
+        for (size_t length = 0; length < bytes.size(); ++length) {
+            truncations += loadFails(bytes.substr(0, length)) ? 1 : 0;
+        }
+        CHECK(truncations == bytes.size());
+        CHECK(loadFails(bytes + "x"));
+
+        std::string badMagic = bytes;
+        badMagic[0] = 'X';
+        CHECK(loadFails(badMagic));
+        std::string badVersion = bytes;
+        badVersion[4] = 9;
+        CHECK(loadFails(badVersion));
+        std::string noInterval = bytes;
+        writeWord(noInterval, 16, 0);
+        CHECK(loadFails(noInterval));
+
+        // Counts far past the file size are rejected before anything is allocated
+        std::string hugeRounds = bytes;
+        writeWord(hugeRounds, 24, std::uint64_t(1) << 60);
+        CHECK(loadFails(hugeRounds));
+        std::string hugeApplicants = bytes;
+        writeWord(hugeApplicants, 8, std::uint64_t(1) << 60);
+        CHECK(loadFails(hugeApplicants));
+        std::string hugeValues = bytes;
+        writeWord(hugeValues, 32, std::uint64_t(1) << 62);
+        CHECK(loadFails(hugeValues));
+
+        // A bitmap bit without a value, and a varint cut short
+        std::string extraBit = bytes;
+        extraBit[bitmapOffset] = static_cast<char>(extraBit[bitmapOffset] ^ 0x01);
+        CHECK(loadFails(extraBit));
+        std::string danglingVarint = bytes;
+        danglingVarint.back() = static_cast<char>(0x80);
+        CHECK(loadFails(danglingVarint));
+
+        // Moving a changed bit from applicant 69 into the padding past the last applicant keeps
+        // the value count right, so only decoding can catch it
+        std::string paddingBit = bytes;
+        size_t lastWord = bitmapOffset + 8;
+        CHECK((paddingBit[lastWord] & 0x20) != 0);
+        paddingBit[lastWord] = static_cast<char>((paddingBit[lastWord] & ~0x20) | 0x40);
+        CHECK(loadFails(paddingBit));
+
+        CHECK_THROWS(RoundDeltaStore::load("round_delta_store_test_missing.bin"));
+        std::remove(storePath.c_str());
+    }
+}
+
+int main() {
+    testRoundTrip();
+    testCorruptFilesRejected();
+    return CollegeCounselingTests::failureCount();
+}
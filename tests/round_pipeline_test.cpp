@@ -0,0 +1,215 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/AllocationJournal.h"
+#include "CollegeCounseling/RoundPipeline.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationJournal;
+using CollegeCounseling::AllocationRecord;
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::CheckpointWriter;
+using CollegeCounseling::CollegeApplication;
+using CollegeCounseling::RoundPipeline;
+using CollegeCounseling::RoundState;
+
+namespace {
+    const std::string checkpointPath = "round_pipeline_test.ckpt";
+    const std::string journalPath = "round_pipeline_test.journal";
+    const int collegeCount = 7;
+    const std::uint32_t snapshotVersion = 42;
+
+    // Maps a rank to one of the colleges, leaving every eleventh rank unallocated, and stands in
+    // for a crash by throwing once the given number of batch lookups, counted across all rounds,
+    // have succeeded
+    class RankModuloStrategy : public AllocationStrategy {
+    private:
+        int offset;
+        int* lookupsLeft;
+
+    public:
+        RankModuloStrategy(int roundOffset, int* failAfter) : offset(roundOffset), lookupsLeft(failAfter) {}
+
+        std::string allocateCollege(int userRank) const override {
+            return std::to_string(allocateCollegeId(userRank));
+        }
+
+        int allocateCollegeId(int userRank) const override {
+            return userRank % 11 == 0 ? noCollegeId : (userRank + offset) % collegeCount;
+        }
+
+        void allocateCollegeIds(const std::int32_t* userRanks, std::int32_t* collegeIds, size_t count) const override {
+            if (lookupsLeft && (*lookupsLeft)-- == 0) {
+                throw std::runtime_error("Error: Simulated crash.");
+            }
+            AllocationStrategy::allocateCollegeIds(userRanks, collegeIds, count);
+        }
+    };
+
+    std::vector<CollegeApplication> applications() {
+        std::mt19937 random(52);
+        std::vector<CollegeApplication> result;
+        for (int id = 0; id < 5000; ++id) {
+            result.emplace_back(id, "Applicant " + std::to_string(id), std::uniform_int_distribution<int>(1, 100000)(random));
+        }
+        return result;
+    }
+
+    // Three rounds of 5000 applicants take five batch lookups each
+    RoundPipeline pipeline(int* failAfter, std::vector<RankModuloStrategy>& strategies) {
+        strategies.clear();
+        for (int round = 0; round < 3; ++round) {
+            strategies.emplace_back(round, failAfter);
+        }
+        return RoundPipeline({ &strategies[0], &strategies[1], &strategies[2] }, collegeCount, snapshotVersion);
+    }
+
+    void removeCheckpoint() {
+        std::remove(checkpointPath.c_str());
+        for (int round = 1; round <= 3; ++round) {
+            std::remove((checkpointPath + ".round" + std::to_string(round)).c_str());
+        }
+    }
+
+    // Resumes from the checkpoint left on disk, if any, until failAfter batch lookups have
+    // succeeded, checkpointing every interval applicants; returns whether the run completed
+    bool runUntilCrash(const std::vector<CollegeApplication>& input, int failAfter, size_t interval) {
+        std::vector<RankModuloStrategy> strategies;
+        RoundPipeline crashing = pipeline(&failAfter, strategies);
+        RoundState state;
+        if (!CheckpointWriter::load(checkpointPath, state) || !crashing.canResume(state, input.size())) {
+            state = crashing.initialState(input.size());
+        }
+        AllocationJournal journal(journalPath);
+        CheckpointWriter checkpoints(checkpointPath);
+        try {
+            crashing.run(input, state, &journal, &checkpoints, interval);
+        } catch (const std::runtime_error&) {
+            // The writer's destructor still writes what was queued, like a checkpoint left on disk
+            return false;
+        }
+        return true;
+    }
+
+    // A loaded checkpoint is consistent with itself: its ledger counts the seats of the decided
+    // prefix of the round in progress, and earlier rounds are complete
+    bool checkpointConsistent(const RoundState& state, const std::vector<std::vector<std::int32_t>>& reference) {
+        for (std::uint32_t round = 0; round < state.round; ++round) {
+            if (state.matching[round] != reference[round]) {
+                return false;
+            }
+        }
+        if (state.round == state.roundCount) {
+            return state.matching.size() == state.roundCount;
+        }
+        const std::vector<std::int32_t>& prefix = state.matching[state.round];
+        std::vector<std::int32_t> seats(collegeCount, 0);
+        for (size_t i = 0; i < prefix.size(); ++i) {
+            if (prefix[i] != reference[state.round][i]) {
+                return false;
+            }
+            if (prefix[i] != AllocationStrategy::noCollegeId) {
+                ++seats[static_cast<size_t>(prefix[i])];
+            }
+        }
+        return prefix.size() == state.cursor && seats == state.seatLedger;
+    }
+
+    // Crashing at every batch lookup, once or twice in a row, and resuming from whatever
+    // checkpoint was left gives the uninterrupted matching, and the journal holds every decision
+    void testResumeAfterCrash() {
+        std::vector<CollegeApplication> input = applications();
+        std::vector<RankModuloStrategy> strategies;
+        RoundPipeline complete = pipeline(nullptr, strategies);
+        RoundState expected = complete.initialState(input.size());
+        complete.run(input, expected, nullptr, nullptr, 0);
+
+        for (int firstCrash = 0; firstCrash < 15; ++firstCrash) {
+            for (int secondCrash : { -1, 2 }) {
+                removeCheckpoint();
+                std::remove(journalPath.c_str());
+                CHECK(!runUntilCrash(input, firstCrash, 700));
+                RoundState left;
+                if (CheckpointWriter::load(checkpointPath, left)) {
+                    CHECK(checkpointConsistent(left, expected.matching));
+                }
+                if (secondCrash >= 0) {
+                    runUntilCrash(input, secondCrash, 700);
+                }
+
+                std::vector<RankModuloStrategy> resumedStrategies;
+                RoundPipeline resumed = pipeline(nullptr, resumedStrategies);
+                RoundState state;
+                bool loaded = CheckpointWriter::load(checkpointPath, state);
+                CHECK(loaded || firstCrash == 0);
+                if (!loaded) {
+                    state = resumed.initialState(input.size());
+                }
+                CHECK(resumed.canResume(state, input.size()));
+                {
+                    AllocationJournal journal(journalPath);
+                    CheckpointWriter checkpoints(checkpointPath);
+                    resumed.run(input, state, &journal, &checkpoints, 700);
+                    checkpoints.discard();
+                }
+                CHECK(state.matching == expected.matching);
+                CHECK(!CheckpointWriter::load(checkpointPath, left));
+
+                std::vector<std::vector<int>> journaled(3, std::vector<int>(input.size(), 0));
+                bool recordsMatch = true;
+                for (const AllocationRecord& record : AllocationJournal::replay(journalPath)) {
+                    size_t round = static_cast<size_t>(record.round - 1);
+                    size_t applicant = static_cast<size_t>(record.applicantId);
+                    recordsMatch = recordsMatch && record.collegeId == expected.matching[round][applicant]
+                                && record.snapshotVersion == snapshotVersion;
+                    journaled[round][applicant] = 1;
+                }
+                CHECK(recordsMatch);
+                CHECK(journaled == std::vector<std::vector<int>>(3, std::vector<int>(input.size(), 1)));
+            }
+        }
+        std::remove(journalPath.c_str());
+    }
+
+    void testDamagedCheckpointRejected() {
+        std::vector<CollegeApplication> input = applications();
+        removeCheckpoint();
+        std::remove(journalPath.c_str());
+        // Two batch lookups into round 2 leave round 1's file and a checkpoint part way through round 2
+        CHECK(!runUntilCrash(input, 7, 700));
+        RoundState state;
+        CHECK(CheckpointWriter::load(checkpointPath, state));
+        CHECK(state.round == 1 && state.cursor > 0);
+
+        std::string bytes;
+        {
+            std::ifstream file(checkpointPath, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        std::string flipped = bytes;
+        flipped[bytes.size() / 2] = static_cast<char>(flipped[bytes.size() / 2] ^ 0x10);
+        std::ofstream(checkpointPath, std::ios::binary | std::ios::trunc) << flipped;
+        CHECK_THROWS(CheckpointWriter::load(checkpointPath, state));
+        std::ofstream(checkpointPath, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 9);
+        CHECK_THROWS(CheckpointWriter::load(checkpointPath, state));
+
+        // A checkpoint whose completed round file is gone cannot be resumed
+        std::ofstream(checkpointPath, std::ios::binary | std::ios::trunc) << bytes;
+        std::remove((checkpointPath + ".round1").c_str());
+        CHECK_THROWS(CheckpointWriter::load(checkpointPath, state));
+        removeCheckpoint();
+        std::remove(journalPath.c_str());
+    }
+}
+
+int main() {
+    testResumeAfterCrash();
+    testDamagedCheckpointRejected();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,204 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "CollegeCounseling/SeatMatrixSnapshot.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::RankIntervalStrategy;
+using CollegeCounseling::SeatMatrixSnapshot;
+
+namespace {
+    // Brute-force model: one row per ID, removed rows keep their name with an empty range
+    struct ModelRow {
+        int rankStart;
+        int rankEnd;
+        std::string college;
+    };
+
+    using Model = std::vector<ModelRow>;
+
+    const int maxRank = 5000;
+
+    int modelCollegeId(const Model& model, int rank) {
+        for (size_t id = 0; id < model.size(); ++id) {
+            if (model[id].rankStart <= rank && rank <= model[id].rankEnd) {
+                return static_cast<int>(id);
+            }
+        }
+        return AllocationStrategy::noCollegeId;
+    }
+
+    // Compares every row and a spread of ranks, including ones outside all intervals
+    bool matches(const SeatMatrixSnapshot& snapshot, const Model& model) {
+        if (snapshot.getCollegeCount() != static_cast<int>(model.size())) {
+            return false;
+        }
+        size_t live = 0;
+        for (size_t id = 0; id < model.size(); ++id) {
+            std::pair<int, int> interval = snapshot.getRankInterval(static_cast<int>(id));
+            bool modelLive = model[id].rankStart <= model[id].rankEnd;
+            bool snapshotLive = interval.first <= interval.second;
+            if (modelLive != snapshotLive || (modelLive && interval != std::make_pair(model[id].rankStart, model[id].rankEnd))
+                || snapshot.getCollegeName(static_cast<int>(id)) != model[id].college) {
+                return false;
+            }
+            live += modelLive ? 1 : 0;
+        }
+        if (snapshot.getIntervalCount() != live) {
+            return false;
+        }
+        for (int rank = -2; rank <= maxRank + 2; rank += 7) {
+            if (snapshot.allocateCollegeId(rank) != modelCollegeId(model, rank)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::pair<int, int> randomRange(std::mt19937& random) {
+        int start = std::uniform_int_distribution<int>(0, maxRank)(random);
+        int length = std::uniform_int_distribution<int>(0, 60)(random);
+        return { start, std::min(maxRank, start + length) };
+    }
+
+    // Random adds, removals and resizes checked against the model every few edits. The table
+    // grows past two B+-tree levels (root splits) and the row trie past two levels, then
+    // shrinks back to nothing, so leaves and inner nodes underflow and merge on the way down.
+    // Every 50th snapshot is kept and rechecked at the end: later edits must not reach it.
+    void testRandomEdits() {
+        std::mt19937 random(20240617);
+        SeatMatrixSnapshot snapshot;
+        Model model;
+        std::vector<std::pair<SeatMatrixSnapshot, Model>> kept;
+        bool consistent = true;
+
+        for (int step = 0; step < 6000 && consistent; ++step) {
+            bool growing = step < 3500;
+            int choice = std::uniform_int_distribution<int>(0, 9)(random);
+            std::vector<int> liveIds;
+            for (size_t id = 0; id < model.size(); ++id) {
+                if (model[id].rankStart <= model[id].rankEnd) {
+                    liveIds.push_back(static_cast<int>(id));
+                }
+            }
+            if (liveIds.empty() || (growing && choice < 6) || (!growing && choice < 1)) {
+                std::pair<int, int> range = randomRange(random);
+                std::string college = "College " + std::to_string(model.size() % 700);
+                snapshot = snapshot.withInterval(range.first, range.second, college);
+                model.push_back({ range.first, range.second, college });
+            } else if (choice < 8 || !growing) {
+                int id = liveIds[std::uniform_int_distribution<size_t>(0, liveIds.size() - 1)(random)];
+                snapshot = snapshot.withoutInterval(id);
+                model[static_cast<size_t>(id)].rankStart = 0;
+                model[static_cast<size_t>(id)].rankEnd = -1;
+            } else {
+                int id = std::uniform_int_distribution<int>(0, static_cast<int>(model.size()) - 1)(random);
+                std::pair<int, int> range = randomRange(random);
+                snapshot = snapshot.withRankInterval(id, range.first, range.second);
+                model[static_cast<size_t>(id)].rankStart = range.first;
+                model[static_cast<size_t>(id)].rankEnd = range.second;
+            }
+            if (step % 5 == 0 || step % 50 == 49) {
+                consistent = matches(snapshot, model);
+            }
+            if (step % 50 == 0) {
+                kept.emplace_back(snapshot, model);
+            }
+        }
+        CHECK(consistent);
+        CHECK(model.size() > 32 * 32);
+        for (const auto& entry : kept) {
+            CHECK(matches(entry.first, entry.second));
+        }
+    }
+
+    // Removing every interval in ID order (scattered start order) empties a three-level tree
+    // through repeated merges and root collapses; the source snapshot stays intact
+    void testDrainToEmpty() {
+        SeatMatrixSnapshot full;
+        Model model;
+        for (int id = 0; id < 2000; ++id) {
+            int start = (id * 37) % maxRank;
+            full = full.withInterval(start, start + 3, "C" + std::to_string(id));
+            model.push_back({ start, start + 3, "C" + std::to_string(id) });
+        }
+        CHECK(matches(full, model));
+
+        SeatMatrixSnapshot drained = full;
+        Model drainedModel = model;
+        for (int id = 0; id < 2000; ++id) {
+            drained = drained.withoutInterval(id);
+            drainedModel[static_cast<size_t>(id)] = { 0, -1, model[static_cast<size_t>(id)].college };
+            if (id % 97 == 0) {
+                CHECK(matches(drained, drainedModel));
+            }
+        }
+        CHECK(drained.getIntervalCount() == 0);
+        CHECK(drained.allocateCollegeId(model[5].rankStart) == AllocationStrategy::noCollegeId);
+        // Refilling the emptied tree still works
+        drained = drained.withRankInterval(7, 10, 20);
+        CHECK(drained.allocateCollegeId(15) == 7);
+        CHECK(matches(full, model));
+    }
+
+    // An edit copies only its path, so the new snapshot shares almost all nodes with the old one
+    void testStructuralSharing() {
+        SeatMatrixSnapshot base;
+        for (int id = 0; id < 4000; ++id) {
+            base = base.withInterval(id, id, "C" + std::to_string(id));
+        }
+        SeatMatrixSnapshot edited = base.withRankInterval(1234, 9000, 9001);
+        std::unordered_set<const void*> seen;
+        size_t baseBytes = base.addUniqueNodeBytes(seen);
+        size_t extraBytes = edited.addUniqueNodeBytes(seen);
+        CHECK(extraBytes > 0);
+        CHECK(extraBytes * 20 < baseBytes);
+        CHECK(base.allocateCollegeId(1234) == 1234);
+        CHECK(edited.allocateCollegeId(1234) == AllocationStrategy::noCollegeId);
+        CHECK(edited.allocateCollegeId(9000) == 1234);
+    }
+
+    // Overlapping intervals resolve to the lowest ID, as in RankIntervalStrategy
+    void testFirstMatchAgainstTable() {
+        RankIntervalStrategy table(MappedFile::fromString("1-100:A\n50-60:B\n40-200:C\n300-310:D\n"));
+        SeatMatrixSnapshot snapshot(table);
+        for (int rank = 0; rank <= 320; ++rank) {
+            CHECK(snapshot.allocateCollegeId(rank) == table.allocateCollegeId(rank));
+        }
+        SeatMatrixSnapshot withoutA = snapshot.withoutInterval(0);
+        CHECK(withoutA.allocateCollegeId(55) == 1);
+        CHECK(withoutA.allocateCollegeId(45) == 2);
+        CHECK(snapshot.allocateCollegeId(55) == 0);
+        CHECK_THROWS(snapshot.withoutInterval(4));
+        CHECK_THROWS(snapshot.withRankInterval(1, 10, 5));
+    }
+
+    // updatedTo edits only differing rows, appends new ones and withdraws missing ones
+    void testUpdatedTo() {
+        RankIntervalStrategy first(MappedFile::fromString("1-10:A\n11-20:B\n21-30:C\n"));
+        RankIntervalStrategy second(MappedFile::fromString("1-12:A\n13-20:B\n21-30:E\n31-40:F\n"));
+        RankIntervalStrategy third(MappedFile::fromString("1-12:A\n"));
+        SeatMatrixSnapshot start(first);
+        SeatMatrixSnapshot next = start.updatedTo(second);
+        SeatMatrixSnapshot last = next.updatedTo(third);
+        CHECK(matches(start, { { 1, 10, "A" }, { 11, 20, "B" }, { 21, 30, "C" } }));
+        CHECK(matches(next, { { 1, 12, "A" }, { 13, 20, "B" }, { 21, 30, "E" }, { 31, 40, "F" } }));
+        CHECK(matches(last, { { 1, 12, "A" }, { 0, -1, "B" }, { 0, -1, "E" }, { 0, -1, "F" } }));
+    }
+}
+
+int main() {
+    testRandomEdits();
+    testDrainToEmpty();
+    testStructuralSharing();
+    testFirstMatchAgainstTable();
+    testUpdatedTo();
+    return CollegeCounselingTests::failureCount();
+}
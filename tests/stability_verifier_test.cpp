@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CollegeCounseling/Matching.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "check.h"
+
+using CollegeCounseling::AllocationStrategy;
+using CollegeCounseling::BlockingPair;
+using CollegeCounseling::CollegeApplication;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::PreferenceTable;
+using CollegeCounseling::RankIntervalStrategy;
+using CollegeCounseling::SerialDictatorship;
+using CollegeCounseling::StabilityReport;
+using CollegeCounseling::StabilityVerifier;
+
+namespace {
+    // Blocking pairs as (applicant index, college ID)
+    using PairSet = std::set<std::pair<size_t, std::int32_t>>;
+
+    std::vector<std::uint32_t> identityOrder(size_t count) {
+        std::vector<std::uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        return order;
+    }
+
+    PreferenceTable listsOf(const std::vector<std::vector<std::int32_t>>& lists) {
+        PreferenceTable table;
+        for (const std::vector<std::int32_t>& list : lists) {
+            table.add(list.data(), list.size());
+        }
+        return table;
+    }
+
+    PairSet pairsOf(const StabilityReport& report) {
+        PairSet pairs;
+        for (const BlockingPair& pair : report.blockingPairs) {
+            pairs.emplace(pair.applicantIndex, pair.collegeId);
+        }
+        return pairs;
+    }
+
+    // Three applicants in merit order 0, 1, 2 who all prefer college 0 (one seat) to college 1
+    // (two seats). Serial dictatorship is stable; each seeded fault is reported as itself.
+    void testSeededFaults() {
+        std::vector<std::uint32_t> order = identityOrder(3);
+        PreferenceTable preferences = listsOf({ { 0, 1 }, { 0, 1 }, { 0, 1 } });
+        std::vector<int> capacities = { 1, 2 };
+        std::vector<std::int32_t> stable = SerialDictatorship::allocate(order, preferences, capacities);
+        CHECK(stable == std::vector<std::int32_t>({ 0, 1, 1 }));
+        CHECK(StabilityVerifier::verify(order, preferences, capacities, stable).isStable());
+
+        // Applicant 0 displaced by the weaker applicant 1: the pair (0, college 0) blocks
+        StabilityReport swapped = StabilityVerifier::verify(order, preferences, capacities, { 1, 0, 1 });
+        CHECK(pairsOf(swapped) == PairSet({ { 0, 0 } }));
+        CHECK(swapped.overfilledColleges.empty() && swapped.unlistedAssignments.empty());
+
+        // College 0 left empty: everyone listing it above their seat would take it, while the full
+        // college 1 admitted only stronger applicants than the unplaced applicant 2
+        StabilityReport freeSeat = StabilityVerifier::verify(order, preferences, capacities, { 1, 1, AllocationStrategy::noCollegeId });
+        CHECK(pairsOf(freeSeat) == PairSet({ { 0, 0 }, { 1, 0 }, { 2, 0 } }));
+
+        StabilityReport overfilled = StabilityVerifier::verify(order, preferences, capacities, { 0, 0, 1 });
+        CHECK(overfilled.overfilledColleges == std::vector<std::int32_t>({ 0 }));
+        CHECK(!overfilled.isStable());
+
+        StabilityReport unlisted = StabilityVerifier::verify(order, listsOf({ { 0 }, { 1 }, {} }), capacities, { 0, 1, 1 });
+        CHECK(unlisted.unlistedAssignments == std::vector<size_t>({ 2 }));
+        CHECK(unlisted.blockingPairs.empty());
+
+        CHECK_THROWS(StabilityVerifier::verify(order, preferences, capacities, { 0, 1 }));
+        CHECK_THROWS(StabilityVerifier::verify(order, preferences, capacities, { 0, 5, 1 }));
+    }
+
+    // Blocking pairs by definition: a college listed above the applicant's seat that has a
+    // free seat or admitted someone of lower merit
+    PairSet bruteForcePairs(const std::vector<std::uint32_t>& order, const PreferenceTable& preferences,
+                                                               const std::vector<int>& capacities, const std::vector<std::int32_t>& result) {
+        std::vector<size_t> merit(order.size());
+        for (size_t position = 0; position < order.size(); ++position) {
+            merit[order[position]] = position;
+        }
+        PairSet pairs;
+        for (size_t applicant = 0; applicant < result.size(); ++applicant) {
+            for (std::uint32_t k = preferences.offsets[applicant]; k < preferences.offsets[applicant + 1]; ++k) {
+                std::int32_t college = preferences.colleges[k];
+                if (college == result[applicant]) {
+                    break;
+                }
+                int admitted = 0;
+                bool weakerAdmitted = false;
+                for (size_t other = 0; other < result.size(); ++other) {
+                    if (result[other] == college) {
+                        ++admitted;
+                        weakerAdmitted = weakerAdmitted || merit[other] > merit[applicant];
+                    }
+                }
+                if (admitted < capacities[static_cast<size_t>(college)] || weakerAdmitted) {
+                    pairs.emplace(applicant, college);
+                }
+            }
+        }
+        return pairs;
+    }
+
+    // Real seat matrices and preference lists: capacities from the rank intervals, lists from the
+    // window model. Serial dictatorship over them certifies; a rank-interval allocation that
+    // leaves a better college's seats empty, or one with random applicants moved, is reported
+    // exactly as the brute-force definition says, for any worker count
+    void testAgainstBruteForce() {
+        std::mt19937 random(58);
+        for (int round = 0; round < 40; ++round) {
+            std::string text;
+            int collegeCount = std::uniform_int_distribution<int>(1, 8)(random);
+            int rank = 1;
+            for (int college = 0; college < collegeCount; ++college) {
+                int seats = std::uniform_int_distribution<int>(1, 6)(random);
+                text += std::to_string(rank) + "-" + std::to_string(rank + seats - 1) + ":C" + std::to_string(college) + "\n";
+                rank += seats;
+            }
+            RankIntervalStrategy table(MappedFile::fromString(text));
+            std::vector<int> capacities;
+            for (int id = 0; id < table.getCollegeCount(); ++id) {
+                capacities.push_back(table.getCollegeCapacity(id));
+            }
+
+            // Applicants take distinct ranks, some past the last interval, and not every rank is taken
+            std::vector<int> ranks(static_cast<size_t>(rank + 5));
+            std::iota(ranks.begin(), ranks.end(), 1);
+            std::shuffle(ranks.begin(), ranks.end(), random);
+            ranks.resize(std::uniform_int_distribution<size_t>(1, ranks.size())(random));
+            std::vector<CollegeApplication> applications;
+            for (size_t i = 0; i < ranks.size(); ++i) {
+                applications.emplace_back(static_cast<int>(i), "A" + std::to_string(i), ranks[i]);
+            }
+            std::vector<std::uint32_t> order = identityOrder(applications.size());
+            std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return ranks[a] < ranks[b]; });
+            PreferenceTable preferences = PreferenceTable::fromRankIntervals(table, applications, 2);
+
+            std::vector<std::int32_t> stable = SerialDictatorship::allocate(order, preferences, capacities);
+            CHECK(StabilityVerifier::verify(order, preferences, capacities, stable, 3).isStable());
+
+            std::vector<std::int32_t> byInterval(applications.size());
+            for (size_t i = 0; i < applications.size(); ++i) {
+                byInterval[i] = table.allocateCollegeId(ranks[i]);
+            }
+            std::vector<std::int32_t> moved = stable;
+            for (int m = 0; m < 3; ++m) {
+                size_t applicant = std::uniform_int_distribution<size_t>(0, moved.size() - 1)(random);
+                moved[applicant] = std::uniform_int_distribution<std::int32_t>(-1, collegeCount - 1)(random);
+            }
+            for (const std::vector<std::int32_t>& result : { byInterval, moved }) {
+                PairSet expected = bruteForcePairs(order, preferences, capacities, result);
+                for (unsigned workers : { 1u, 4u }) {
+                    StabilityReport report = StabilityVerifier::verify(order, preferences, capacities, result, workers);
+                    CHECK(pairsOf(report) == expected);
+                    CHECK(report.blockingPairs.size() == expected.size());
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    testSeededFaults();
+    testAgainstBruteForce();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CollegeCounseling/PhiloxRng.h"
+#include "CollegeCounseling/RankIntervalStrategy.h"
+#include "CollegeCounseling/WhatIfSimulator.h"
+#include "check.h"
+
+using CollegeCounseling::CollegeApplication;
+using CollegeCounseling::LotteryTieBreaker;
+using CollegeCounseling::MappedFile;
+using CollegeCounseling::PhiloxRng;
+using CollegeCounseling::RankIntervalStrategy;
+using CollegeCounseling::ScenarioSettings;
+using CollegeCounseling::SimulationSummary;
+using CollegeCounseling::WhatIfSimulator;
+
+namespace {
+    struct KnownAnswer {
+        std::uint32_t counter[4];
+        std::uint32_t key[2];
+        std::uint32_t expected[4];
+    };
+
+    // Philox4x32-10 vectors from the Random123 distribution (kat_vectors)
+    void testPhiloxKnownAnswers() {
+        const KnownAnswer answers[] = {
+            { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 },
+              { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+            { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+              { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+            { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+              { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } },
+        };
+        for (const KnownAnswer& answer : answers) {
+            std::uint32_t result[4];
+            PhiloxRng::block(answer.key, answer.counter, result);
+            CHECK(result[0] == answer.expected[0] && result[1] == answer.expected[1] && result[2] == answer.expected[2]
+                  && result[3] == answer.expected[3]);
+        }
+    }
+
+    // A generator draws the blocks of counters 0, 1, 2... in its stream, in word order, keyed by the seed
+    void testStreamLayout() {
+        const std::uint64_t seed = 0x0123456789abcdefull;
+        const std::uint64_t stream = 0xfedcba9876543210ull;
+        PhiloxRng rng(seed, stream);
+        const std::uint32_t key[2] = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+        bool matches = true;
+        for (std::uint32_t position = 0; position < 3; ++position) {
+            const std::uint32_t counter[4] = { position, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) };
+            std::uint32_t block[4];
+            PhiloxRng::block(key, counter, block);
+            for (std::uint32_t word : block) {
+                matches = matches && rng.next() == word;
+            }
+        }
+        CHECK(matches);
+
+        PhiloxRng other(seed, stream + 1);
+        PhiloxRng same(seed, stream);
+        CHECK(other.next() != same.next());
+        bool inRange = true;
+        for (int i = 0; i < 10000; ++i) {
+            double unit = rng.nextUnit();
+            inRange = inRange && unit >= 0.0 && unit < 1.0;
+        }
+        CHECK(inRange);
+    }
+
+    // 3000 applicants over 300 distinct ranks, so most ranks are shared and the lottery decides
+    std::vector<CollegeApplication> tiedApplicants() {
+        std::mt19937 random(57);
+        std::vector<CollegeApplication> applications;
+        for (int id = 0; id < 3000; ++id) {
+            int rank = std::uniform_int_distribution<int>(1, 300)(random) * 10;
+            applications.emplace_back(id, "Applicant " + std::to_string(id), rank);
+        }
+        return applications;
+    }
+
+    void testMeritOrderIndependentOfWorkers() {
+        std::vector<CollegeApplication> applications = tiedApplicants();
+        LotteryTieBreaker tieBreaker(2024);
+        std::vector<std::uint32_t> serial = tieBreaker.meritOrder(applications, 1);
+        bool sorted = true;
+        for (size_t i = 1; i < serial.size(); ++i) {
+            sorted = sorted && applications[serial[i - 1]].getApplicantRank() <= applications[serial[i]].getApplicantRank();
+        }
+        CHECK(sorted);
+        for (unsigned workers : { 2u, 3u, 7u, 16u }) {
+            CHECK(tieBreaker.meritOrder(applications, workers) == serial);
+        }
+        CHECK(LotteryTieBreaker(2025).meritOrder(applications, 1) != serial);
+    }
+
+    bool sameSummary(const SimulationSummary& a, const SimulationSummary& b) {
+        return a.scenarioCount == b.scenarioCount && a.meanSeatsFilled == b.meanSeatsFilled && a.closingRanks == b.closingRanks
+            && a.unallocated == b.unallocated;
+    }
+
+    // Scenario s draws from stream s whichever worker runs it, so every worker count gives the
+    // same summary, down to the bits of the mean fills
+    void testSimulationIndependentOfWorkers() {
+        std::string text;
+        for (int college = 0; college < 20; ++college) {
+            int start = college * 150 + 1;
+            text += std::to_string(start) + "-" + std::to_string(start + 99 + college % 4 * 40) + ":College " + std::to_string(college) + "\n";
+        }
+        RankIntervalStrategy table(MappedFile::fromString(text));
+        std::vector<CollegeApplication> applications = tiedApplicants();
+        ScenarioSettings settings;
+        settings.preferenceWindow = 4;
+        settings.tieBreakSeed = 99;
+        WhatIfSimulator simulator(table, applications, settings);
+
+        SimulationSummary serial = simulator.run(48, 12345, 1);
+        CHECK(serial.scenarioCount == 48);
+        CHECK(serial.meanSeatsFilled.size() == 20);
+        for (unsigned workers : { 2u, 5u, 16u, 64u }) {
+            CHECK(sameSummary(simulator.run(48, 12345, workers), serial));
+        }
+        CHECK(!sameSummary(simulator.run(48, 54321, 4), serial));
+        // A prefix of the scenarios is the same with fewer of them
+        SimulationSummary prefix = simulator.run(10, 12345, 3);
+        CHECK(prefix.unallocated == std::vector<std::int64_t>(serial.unallocated.begin(), serial.unallocated.begin() + 10));
+    }
+}
+
+int main() {
+    testPhiloxKnownAnswers();
+    testStreamLayout();
+    testMeritOrderIndependentOfWorkers();
+    testSimulationIndependentOfWorkers();
+    return CollegeCounselingTests::failureCount();
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Times the CLI of several builds on the same workloads and reports the best wall time of each
+// command plus the speedup over the first (baseline) build. Every build runs in the same working
+// directory, which must hold the counseling.conf naming the seat matrix and the default journal
+// and checkpoint paths. Those files are deleted before every run, so each repeat does the same I/O.
+// Usage: counseling_benchmark <work dir> <applicants csv> <repeats> <label=executable>...
+
+#ifdef _WIN32
+static const char* const discardOutput = " > NUL";
+#else
+static const char* const discardOutput = " > /dev/null";
+#endif
+
+// One CLI invocation and the files it appends to, which are deleted before each run
+struct Workload {
+    std::string arguments;
+    std::vector<std::string> resetFiles;
+};
+
+// Best-of-repeats wall time of one command, in seconds
+static double timeCommand(const std::string& command, const std::vector<std::string>& resetFiles, int repeats) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i) {
+        for (const std::string& path : resetFiles) {
+            std::remove(path.c_str());
+        }
+        auto start = std::chrono::steady_clock::now();
+        if (std::system(command.c_str()) != 0) {
+            throw std::runtime_error("Error: Benchmark command failed: " + command);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 5) {
+            throw std::runtime_error("Usage: counseling_benchmark <work dir> <applicants csv> <repeats> <label=executable>...");
+        }
+        std::string workDir = argv[1];
+        std::string applicants = argv[2];
+        int repeats = std::max(1, std::stoi(argv[3]));
+
+        // The dry run covers only the CSV parse and lookups; the batch run adds the journal and
+        // writes the round results the other commands read back
+        const std::string journal = workDir + "/allocation_journal.bin";
+        const std::string checkpoint = workDir + "/round_checkpoint.bin";
+        const std::vector<Workload> workloads = {
+            { "--dry-run \"" + applicants + "\" 5", {} },
+            { "--batch \"" + applicants + "\" 100000", { journal, checkpoint } },
+            { "--analytics \"" + applicants + "\" 1", {} },
+            { "--diff \"" + applicants + "\" 1 2", {} },
+        };
+
+        std::vector<std::string> labels;
+        std::vector<std::vector<double>> timings;
+        for (int i = 4; i < argc; ++i) {
+            std::string build = argv[i];
+            size_t separator = build.find('=');
+            if (separator == std::string::npos) {
+                throw std::runtime_error("Error: Builds are given as label=executable.");
+            }
+            labels.push_back(build.substr(0, separator));
+            std::string executable = build.substr(separator + 1);
+
+            std::vector<double> times;
+            for (const Workload& workload : workloads) {
+                std::string command = "cd \"" + workDir + "\" && \"" + executable + "\" " + workload.arguments + discardOutput;
+                times.push_back(timeCommand(command, workload.resetFiles, repeats));
+            }
+            timings.push_back(times);
+        }
+
+        std::cout << std::fixed << std::setprecision(3);
+        for (size_t w = 0; w < workloads.size(); ++w) {
+            std::cout << workloads[w].arguments.substr(0, workloads[w].arguments.find(' ')) << "\n";
+            for (size_t b = 0; b < labels.size(); ++b) {
+                std::cout << "  " << std::setw(12) << std::left << labels[b] << std::right << std::setw(9) << timings[b][w] << " s";
+                if (b > 0) {
+                    std::cout << "  x" << std::setprecision(2) << timings[0][w] / timings[b][w] << std::setprecision(3);
+                }
+                std::cout << "\n";
+            }
+        }
+        std::cout.flush();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+
+#include "CollegeCounseling/CollegeCounseling.h"
+
+// Writes a reproducible seat matrix whose rank domain is too wide for a dense table and which
+// has enough segments for a coverage filter, so lookups take the filtered grouped search; the
+// same table is also written as a sectioned snapshot for the pager. Intervals are spaced a
+// fixed stride apart and cover about half of it, with every 64th one stretched over its
+// neighbours so first-match resolution has nesting to deal with.
+void writeWideSeatMatrix(const std::string& plainPath, const std::string& sectionedPath, size_t intervals, std::uint64_t seed) {
+    const std::uint32_t stride = 2000;
+    CollegeCounseling::PhiloxRng rng(seed, 1);
+    std::ostringstream table;
+    for (size_t i = 0; i < intervals; ++i) {
+        std::uint32_t start = 1 + static_cast<std::uint32_t>(i) * stride + rng.next() % (stride / 4);
+        std::uint32_t length = i % 64 == 0 ? stride * 8 : rng.next() % (stride / 2);
+        table << start << "-" << start + length << ": Synthetic College " << i << "\n";
+    }
+
+    std::ofstream plain(plainPath, std::ios::binary);
+    plain << table.str();
+    if (!plain) {
+        throw std::runtime_error("Error: Cannot write seat matrix " + plainPath);
+    }
+    CollegeCounseling::RankIntervalStrategy rankStrategy(CollegeCounseling::MappedFile::fromString(table.str(), plainPath));
+    std::ofstream sectioned(sectionedPath, std::ios::binary);
+    rankStrategy.writeSectioned(sectioned, 256);
+}
+
+// Writes a reproducible applicant CSV for training and benchmark runs: ranks spread a tenth past
+// the last interval of the seat matrix (so misses are exercised), mixed categories, and every
+// sixteenth name quoted with an embedded comma. With --seat-matrix it instead writes the wide
+// synthetic seat matrix and its sectioned snapshot.
+// Usage: counseling_workload <seat matrix> <applicants csv> [count] [seed]
+//        counseling_workload --seat-matrix <seat matrix> <sectioned snapshot> [intervals] [seed]
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3 || (std::string(argv[1]) == "--seat-matrix" && argc < 4)) {
+            throw std::runtime_error("Usage: counseling_workload <seat matrix> <applicants csv> [count] [seed]\n"
+                                     "       counseling_workload --seat-matrix <seat matrix> <sectioned snapshot> [intervals] [seed]");
+        }
+        if (std::string(argv[1]) == "--seat-matrix") {
+            writeWideSeatMatrix(argv[2], argv[3], argc >= 5 ? std::stoul(argv[4]) : 40000, argc >= 6 ? std::stoull(argv[5]) : 1);
+            return 0;
+        }
+        size_t count = argc >= 4 ? std::stoul(argv[3]) : 300000;
+        std::uint64_t seed = argc >= 5 ? std::stoull(argv[4]) : 1;
+
+        CollegeCounseling::RankIntervalStrategy rankStrategy(argv[1]);
+        const auto& segmentStarts = rankStrategy.getSegmentStarts();
+        if (segmentStarts.empty()) {
+            throw std::runtime_error("Error: Seat matrix has no intervals.");
+        }
+        std::uint32_t rankLimit = static_cast<std::uint32_t>(segmentStarts.back()) + static_cast<std::uint32_t>(segmentStarts.back()) / 10 + 1;
+
+        std::ofstream output(argv[2], std::ios::binary);
+        if (!output.is_open()) {
+            throw std::runtime_error("Error: Cannot write applicant file.");
+        }
+        static const char* const categories[] = { "GM", "OBC", "SC", "ST", "EWS" };
+        CollegeCounseling::PhiloxRng rng(seed, 0);
+        output << "name,rank,category\n";
+        for (size_t i = 0; i < count; ++i) {
+            std::uint32_t rank = 1 + rng.next() % rankLimit;
+            const char* category = categories[rng.next() % 5];
+            if (i % 16 == 0) {
+                output << "\"Applicant, " << i << "\"," << rank << "," << category << "\n";
+            } else {
+                output << "Applicant " << i << "," << rank << "," << category << "\n";
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}